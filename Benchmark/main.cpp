@@ -0,0 +1,332 @@
+// main.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+// Compares OpenCL generation of every device with the original CPU FastNoise library
+// Both sides are configured from the same Noise, Fractal and Perturb objects. For every case
+// output parity is checked and throughput is reported for growing sizes, together with the
+// crossover size from which the device stays faster than single threaded FastNoise.
+// CPU OpenCL runtimes are listed like any other device. FastNoise has no 1D noise, so
+// only 2D, 3D and 4D cases are compared.
+//
+// Usage: Benchmark [repetitions]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+
+#include "CLNoise/CLNoise.h"
+#include "FastNoise.h"
+
+using namespace std;
+
+// Largest difference still counted as parity, devices may fuse multiply-add
+const float max_difference = 1e-3f;
+size_t repetitions = 5;
+
+//! \brief objects a case configures, kept alive while generator uses them
+struct Setup {
+    Noise noise;
+    Fractal fractal;
+    Fractal perturbFractal;
+    Perturb perturb;
+
+    Setup() : fractal(3, 2.0f, 0.5f), perturbFractal(3, 2.0f, 0.5f) {
+        perturb.setAmplitude(30.0f);
+        perturb.setFrequency(0.02f);
+        perturb.setFractal(&perturbFractal);
+    }
+};
+
+/*! \brief FastNoise configured like a Noise
+ * Perturb has own seed, frequency and fractal, so it is a second FastNoise object.
+ * CLNoise enums are declared in the same order as the FastNoise ones
+ */
+struct Reference {
+    FastNoise noise;
+    FastNoise warp;
+    NoiseType type;
+    PerturbType perturbType;
+
+    Reference(const Noise& n) {
+        type = n.getNoiseType();
+        noise.SetSeed(n.getSeed());
+        noise.SetFrequency(n.getFrequency());
+        noise.SetInterp(FastNoise::Interp(n.getSmoothingFunction()));
+        noise.SetNoiseType(FastNoise::NoiseType(type));
+        noise.SetFractalType(FastNoise::FractalType(n.getFractalType()));
+        if (const Fractal* f = n.getFractal()) {
+            noise.SetFractalOctaves(f->getOctaves());
+            noise.SetFractalLacunarity(f->getLacunarity());
+            noise.SetFractalGain(f->getGain());
+        }
+        noise.SetCellularDistanceFunction(FastNoise::CellularDistanceFunction(n.getCellularDistanceFunction()));
+        noise.SetCellularReturnType(FastNoise::CellularReturnType(n.getCellularReturnType()));
+        noise.SetCellularJitter(n.getCellularJitter());
+        noise.SetCellularDistance2Indices(n.getcellularDistanceIndex0(), n.getcellularDistanceIndex1());
+
+        const Perturb* p = n.getPerturb();
+        perturbType = p ? p->getPerturbType() : PerturbType::None;
+        if (perturbType != PerturbType::None) {
+            warp.SetSeed(p->getSeed());
+            warp.SetFrequency(p->getFrequency());
+            warp.SetInterp(FastNoise::Interp(p->getSmoothingFunction()));
+            warp.SetGradientPerturbAmp(p->getAmplitude());
+            if (const Fractal* f = p->getFractal()) {
+                warp.SetFractalOctaves(f->getOctaves());
+                warp.SetFractalLacunarity(f->getLacunarity());
+                warp.SetFractalGain(f->getGain());
+            }
+        }
+    }
+
+    float get(float x, float y) {
+        if (perturbType == PerturbType::Single) warp.GradientPerturb(x, y);
+        else if (perturbType == PerturbType::Fractal) warp.GradientPerturbFractal(x, y);
+        return noise.GetNoise(x, y);
+    }
+    float get(float x, float y, float z) {
+        if (perturbType == PerturbType::Single) warp.GradientPerturb(x, y, z);
+        else if (perturbType == PerturbType::Fractal) warp.GradientPerturbFractal(x, y, z);
+        return noise.GetNoise(x, y, z);
+    }
+    // FastNoise has only simplex and white noise in 4D, without perturb
+    float get(float x, float y, float z, float w) {
+        return type == NoiseType::WhiteNoise ? noise.GetWhiteNoise(x, y, z, w) : noise.GetSimplex(x, y, z, w);
+    }
+
+    //! \brief fills samples in the layout of Generator::getNoise
+    void fill(int dimensions, const Range* r, float* out) {
+        size_t sy = r[1].size, sz = dimensions > 2 ? r[2].size : 1, sw = dimensions > 3 ? r[3].size : 1;
+        for (size_t u = 0; u < sw; u++)
+            for (size_t k = 0; k < sz; k++)
+                for (size_t i = 0; i < r[0].size; i++) {
+                    float x = i * r[0].step + r[0].offset;
+                    for (size_t j = 0; j < sy; j++) {
+                        float y = j * r[1].step + r[1].offset;
+                        if (dimensions == 2) *out++ = get(x, y);
+                        else if (dimensions == 3) *out++ = get(x, y, k * r[2].step + r[2].offset);
+                        else *out++ = get(x, y, k * r[2].step + r[2].offset, u * r[3].step + r[3].offset);
+                    }
+                }
+    }
+};
+
+struct Result {
+    size_t samples;
+    double device;
+    double native;
+    float difference;
+};
+
+struct Case {
+    string name;
+    int dimensions;
+    void (*setup)(Setup& s);
+};
+
+// Timing
+template<typename F> double best_time(F f) {
+    double best = 1e30;
+    for (size_t r = 0; r < repetitions; r++) {
+        auto start = chrono::steady_clock::now();
+        f();
+        chrono::duration<double> d = chrono::steady_clock::now() - start;
+        best = min(best, d.count());
+    }
+    return best;
+}
+
+float difference(const NoiseBuffer& b, const vector<float>& native) {
+    if (b.size != native.size()) return INFINITY;
+    float diff = 0;
+    for (size_t i = 0; i < b.size; i++)
+        diff = max(diff, fabs(b.data[i] - native[i]));
+    return diff;
+}
+
+/*! \brief times device and FastNoise generation of a cube with side size for every size
+ * Device is warmed up on the first size, so kernel build is not counted
+ */
+vector<Result> run_case(Generator& generator, const Setup& s, int dims, const vector<size_t>& sizes) {
+    Reference reference(s.noise);
+    vector<Result> results;
+
+    for (size_t size : sizes) {
+        Range r[4] = {
+            Range(size, 0.0f, 1.0f), Range(size, 0.0f, 1.0f),
+            Range(dims > 2 ? size : 1, 0.0f, 1.0f), Range(dims > 3 ? size : 1, 0.0f, 1.0f)
+        };
+        Result res;
+        res.samples = r[0].size * r[1].size * r[2].size * r[3].size;
+
+        auto device = [&]() -> NoiseBuffer {
+            if (dims == 2) return generator.getNoise(r[0], r[1]);
+            if (dims == 3) return generator.getNoise(r[0], r[1], r[2]);
+            return generator.getNoise(r[0], r[1], r[2], r[3]);
+        };
+        vector<float> out(res.samples);
+        auto cpu = [&]() { reference.fill(dims, r, out.data()); };
+
+        NoiseBuffer b = device();
+        cpu();
+        res.difference = difference(b, out);
+        res.device = best_time([&]() { NoiseBuffer t = device(); });
+        res.native = best_time(cpu);
+        results.push_back(res);
+    }
+    return results;
+}
+
+// Cases
+const vector<Case>& get_cases() {
+    static const vector<Case> cases = {
+        { "Value 2D", 2,
+          [](Setup& s) { s.noise.setNoiseType(NoiseType::Value); } },
+        { "Perlin 2D", 2,
+          [](Setup& s) { s.noise.setNoiseType(NoiseType::Perlin); } },
+        { "Simplex 2D", 2,
+          [](Setup& s) { s.noise.setNoiseType(NoiseType::Simplex); } },
+        { "WhiteNoise 2D", 2,
+          [](Setup& s) { s.noise.setNoiseType(NoiseType::WhiteNoise); } },
+        { "Cellular Distance 2D", 2,
+          [](Setup& s) {
+              s.noise.setNoiseType(NoiseType::Cellular);
+              s.noise.setCellularReturnType(CellularReturnType::Distance);
+          } },
+        { "SimplexFractal FBM x3 2D, Perturb", 2,
+          [](Setup& s) {
+              s.noise.setNoiseType(NoiseType::SimplexFractal);
+              s.noise.setFractal(&s.fractal);
+              s.perturb.setPerturbType(PerturbType::Single);
+              s.noise.setPerturb(&s.perturb);
+          } },
+        { "Value 3D", 3,
+          [](Setup& s) { s.noise.setNoiseType(NoiseType::Value); } },
+        { "Simplex 3D", 3,
+          [](Setup& s) { s.noise.setNoiseType(NoiseType::Simplex); } },
+        { "Cellular CellValue 3D", 3,
+          [](Setup& s) { s.noise.setNoiseType(NoiseType::Cellular); } },
+        { "PerlinFractal RigidMulti x3 3D, Perturb fractal x3", 3,
+          [](Setup& s) {
+              s.noise.setNoiseType(NoiseType::PerlinFractal);
+              s.noise.setFractalType(FractalType::RigidMulti);
+              s.noise.setFractal(&s.fractal);
+              s.perturb.setPerturbType(PerturbType::Fractal);
+              s.noise.setPerturb(&s.perturb);
+          } },
+        { "Simplex 4D", 4,
+          [](Setup& s) { s.noise.setNoiseType(NoiseType::Simplex); } },
+    };
+    return cases;
+}
+
+// Sizes are cube sides, so sample counts grow about the same for every dimension count
+vector<size_t> get_sizes(int dimensions) {
+    if (dimensions == 2) return { 16, 32, 64, 128, 256, 512, 1024, 2048 };
+    if (dimensions == 3) return { 8, 16, 24, 32, 48, 64, 96, 128, 160 };
+    return { 4, 6, 8, 12, 16, 24, 32, 40 };
+}
+const char* type_name(DeviceType type) {
+    switch (type) {
+    case DeviceType::CPU: return "CPU";
+    case DeviceType::GPU: return "GPU";
+    case DeviceType::Accelerator: return "Accelerator";
+    case DeviceType::Custom: return "Custom";
+    default: return "Other";
+    }
+}
+
+double rate(size_t samples, double seconds) {
+    return seconds > 0 ? samples / seconds / 1e6 : 0;
+}
+
+// Returns false if any case lost parity
+bool bench_device(const Device& device) {
+    const Device::Info& info = device.getInfo();
+    cout << "== " << info.name << " (" << type_name(info.type) << ", " << info.vendor << ", " << info.version << ")\n";
+
+    Generator generator(device);
+    bool parity = true;
+
+    for (const Case& c : get_cases()) {
+        Setup s;
+        c.setup(s);
+        generator.setNoise(&s.noise);
+
+        vector<size_t> sizes = get_sizes(c.dimensions);
+        vector<Result> results = run_case(generator, s, c.dimensions, sizes);
+
+        cout << "  " << c.name << "\n";
+        cout << "    " << setw(10) << "samples" << setw(14) << "device MS/s" << setw(16) << "FastNoise MS/s"
+             << setw(10) << "speedup" << setw(12) << "max diff" << "\n";
+
+        size_t crossover = 0;
+        float diff = 0;
+        for (const Result& r : results) {
+            double speedup = r.device > 0 ? r.native / r.device : 0;
+            cout << "    " << setw(10) << r.samples
+                 << setw(14) << fixed << setprecision(1) << rate(r.samples, r.device)
+                 << setw(16) << rate(r.samples, r.native)
+                 << setw(9) << setprecision(2) << speedup << "x"
+                 << setw(12) << scientific << setprecision(1) << r.difference << defaultfloat << "\n";
+            diff = max(diff, r.difference);
+        }
+
+        // Smallest size from which the device wins at every larger size, one noisy win does not count
+        for (auto r = results.rbegin(); r != results.rend() && r->device < r->native; ++r)
+            crossover = r->samples;
+
+        if (crossover) cout << "    crossover at " << crossover << " samples\n";
+        else cout << "    device does not stay faster from any size\n";
+        if (diff > max_difference) {
+            cout << "    PARITY FAILED, max difference " << diff << "\n";
+            parity = false;
+        }
+    }
+    return parity;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) repetitions = max(atoi(argv[1]), 1);
+
+    const vector<Device>& devices = Device::getDevices();
+    if (devices.empty()) {
+        cout << "No OpenCL devices found\n";
+        return 1;
+    }
+
+    bool parity = true;
+    for (const Device& device : devices)
+        parity = bench_device(device) && parity;
+
+    return parity ? 0 : 1;
+}
@@ -34,6 +34,18 @@
 #include "Fractal.h"
 #include "Perturb.h"
 #include "Noise.h"
+#include "Executor.h"
 #include "Generator.h"
+#include "PageCache.h"
+#include "Pipeline.h"
+#include "ChunkGrid.h"
+#include "NoiseStream.h"
+#include "CostModel.h"
+#include "SlicedRequest.h"
+#include "QualityGovernor.h"
+#include "NativeNoise.h"
+#include "Calibration.h"
+#include "RequestDeduplicator.h"
+#include "CompletionQueue.h"
 
 #endif
@@ -0,0 +1,134 @@
+// Calibration.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#include "Calibration.h"
+
+#include <math.h>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#define CALIBRATION_CELLS 256.0f
+#define CALIBRATION_SPAN_MAX 1e6f
+
+// NoiseStats
+float NoiseStats::getPercentile(float p) const {
+    p = std::min(std::max(p, 0.0f), 100.0f);
+    int i = std::min((int)p, 99);
+    float t = p - i;
+    return percentiles[i] + (percentiles[i + 1] - percentiles[i]) * t;
+}
+void normalize_range(float* data, size_t size, float low, float high) {
+    float scale = high > low ? 1.0f / (high - low) : 0.0f;
+    for (size_t i = 0; i < size; i++)
+        data[i] = std::min(std::max((data[i] - low) * scale, 0.0f), 1.0f);
+}
+void NoiseStats::normalize(float* data, size_t size) const {
+    normalize_range(data, size, min, max);
+}
+void NoiseStats::normalize(float* data, size_t size, float low, float high) const {
+    normalize_range(data, size, getPercentile(low), getPercentile(high));
+}
+template<typename T>
+void quantize_range(const float* data, size_t size, float low, float high, float levels, T* result) {
+    float scale = high > low ? levels / (high - low) : 0.0f;
+    for (size_t i = 0; i < size; i++)
+        result[i] = (T)(std::min(std::max((data[i] - low) * scale, 0.0f), levels) + 0.5f);
+}
+void NoiseStats::quantize(const float* data, size_t size, unsigned char* result) const {
+    quantize_range(data, size, min, max, 255.0f, result);
+}
+void NoiseStats::quantize(const float* data, size_t size, unsigned short* result) const {
+    quantize_range(data, size, min, max, 65535.0f, result);
+}
+
+// initialization
+Calibration::Calibration(Generator& generator, size_t samples, unsigned int seed) : m_generator(generator) {
+    m_samples = samples ? samples : 1;
+    m_seed = seed;
+}
+Calibration::~Calibration() {}
+
+// Calibration
+const NoiseStats* Calibration::calibrate(int dimensions) {
+    const Noise* noise = m_generator.getNoise();
+    if (!noise || (dimensions != 2 && dimensions != 3)) return nullptr;
+
+    std::pair<unsigned long long, int> key(m_generator.getFingerprint(), dimensions);
+    auto c = m_cache.find(key);
+    if (c != m_cache.end()) return &c->second;
+
+    // Same points for every configuration, spread over a fixed number of cells
+    float frequency = fabs(noise->getFrequency());
+    float span = frequency > 0 ? std::min(CALIBRATION_CELLS / frequency, CALIBRATION_SPAN_MAX) : CALIBRATION_SPAN_MAX;
+    std::mt19937 random(m_seed);
+    std::uniform_real_distribution<float> coord(-span, span);
+
+    std::vector<float> points(m_samples * dimensions);
+    for (size_t i = 0; i < points.size(); i++) points[i] = coord(random);
+
+    NoiseBuffer b = m_generator.getPoints(points.data(), m_samples, dimensions);
+    if (!b.size) return nullptr;
+
+    std::sort(b.data, b.data + b.size);
+
+    NoiseStats stats;
+    stats.samples = b.size;
+    stats.min = b.data[0];
+    stats.max = b.data[b.size - 1];
+
+    double sum = 0;
+    for (size_t i = 0; i < b.size; i++) sum += b.data[i];
+    stats.mean = (float)(sum / b.size);
+
+    for (int p = 0; p <= 100; p++) {
+        double pos = (b.size - 1) * (p / 100.0);
+        size_t i = (size_t)pos;
+        size_t j = std::min(i + 1, b.size - 1);
+        stats.percentiles[p] = b.data[i] + (b.data[j] - b.data[i]) * (float)(pos - i);
+    }
+
+    return &(m_cache[key] = stats);
+}
+bool Calibration::isCached(int dimensions) const {
+    return m_cache.count(std::make_pair(m_generator.getFingerprint(), dimensions)) != 0;
+}
+
+// Getters/Setters
+void Calibration::setSamples(size_t samples) {
+    m_samples = samples ? samples : 1;
+    m_cache.clear();
+}
+size_t Calibration::getSamples() const {
+    return m_samples;
+}
+size_t Calibration::getCacheSize() const {
+    return m_cache.size();
+}
+void Calibration::clear() {
+    m_cache.clear();
+}
@@ -0,0 +1,88 @@
+// Calibration.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef Calibration_H
+#define Calibration_H
+
+#include <cstdlib>
+#include <map>
+#include <utility>
+#include "Generator.h"
+
+//! \brief output distribution of a Noise configuration, estimated from random samples
+struct NoiseStats {
+    float min;
+    float max;
+    float mean;
+    //! \brief percentiles[p] is the value p percent of samples are below
+    float percentiles[101];
+    size_t samples;
+
+    //! \brief Returns percentile p in [0, 100], interpolated between whole percents
+    float getPercentile(float p) const;
+
+    // Single pass helpers with known bounds
+    //! \brief Maps [min, max] to [0, 1] in place, values outside are clamped
+    void normalize(float* data, size_t size) const;
+    //! \brief Maps [getPercentile(low), getPercentile(high)] to [0, 1] in place, values outside are clamped
+    void normalize(float* data, size_t size, float low, float high) const;
+    //! \brief Maps [min, max] to 0-255, values outside are clamped
+    void quantize(const float* data, size_t size, unsigned char* result) const;
+    //! \brief Maps [min, max] to 0-65535, values outside are clamped
+    void quantize(const float* data, size_t size, unsigned short* result) const;
+};
+
+/*! \brief estimates output range of the Noise set on generator by evaluating random points on device
+ * Results are cached by Generator::getFingerprint and dimensions, so a configuration is sampled once.
+ * Points are spread over 256 noise cells per axis. Only 2D and 3D, Cellular NoiseLookup is not supported
+ */
+class Calibration {
+public:
+    //! \brief Create calibration, samples points are evaluated per configuration
+    Calibration(Generator& generator, size_t samples = 1 << 20, unsigned int seed = 1337);
+    ~Calibration();
+
+    //! \brief Returns stats of current Noise, sampling it if not cached. nullptr if not supported
+    const NoiseStats* calibrate(int dimensions);
+    bool isCached(int dimensions) const;
+
+    // Getters/Setters
+    //! \brief Changing sample count clears the cache
+    void setSamples(size_t samples);
+    size_t getSamples() const;
+    size_t getCacheSize() const;
+    void clear();
+
+protected:
+    Generator& m_generator;
+    size_t m_samples;
+    unsigned int m_seed;
+
+    std::map<std::pair<unsigned long long, int>, NoiseStats> m_cache;
+};
+
+#endif
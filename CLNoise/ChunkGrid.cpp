@@ -0,0 +1,179 @@
+// ChunkGrid.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#include "ChunkGrid.h"
+
+#include <cstring>
+
+unsigned long long chunk_key(const ChunkCoord& c) {
+    return ((unsigned long long)(c.x & 0x1fffff) << 42) |
+           ((unsigned long long)(c.y & 0x1fffff) << 21) |
+           (unsigned long long)(c.z & 0x1fffff);
+}
+
+// Box of samples along one axis
+struct AxisPart {
+    size_t size;
+    size_t src;   // first sample inside the chunk that holds this part
+    size_t dst;   // first sample inside assembled chunk
+};
+AxisPart axis_part(int d, size_t n, size_t h) {
+    switch (d) {
+    case -1:
+        return AxisPart{ h, n - h, 0 };
+    case 1:
+        return AxisPart{ h, 0, h + n };
+    default:
+        return AxisPart{ n, 0, h };
+    }
+}
+
+// Part of a chunk interior, coordinates always start from the chunk origin
+SampleBox chunk_box(const ChunkCoord& c, float span, float step, const AxisPart& px, const AxisPart& py, const AxisPart& pz) {
+    SampleBox box;
+    box.origin[0] = c.x * span;
+    box.origin[1] = c.y * span;
+    box.origin[2] = c.z * span;
+    box.start[0] = px.src;
+    box.start[1] = py.src;
+    box.start[2] = pz.src;
+    box.size[0] = px.size;
+    box.size[1] = py.size;
+    box.size[2] = pz.size;
+    box.step = step;
+    return box;
+}
+
+// Copies a part into the assembled chunk, src rows are sizeX * sizeY and the part starts at (x, y, z) of src
+void copy_part(
+    const float* src, size_t sizeX, size_t sizeY, size_t x, size_t y, size_t z,
+    const AxisPart& px, const AxisPart& py, const AxisPart& pz,
+    float* out, size_t e
+) {
+    for (size_t k = 0; k < pz.size; k++)
+        for (size_t i = 0; i < px.size; i++)
+            std::memcpy(
+                out + ((pz.dst + k) * e + px.dst + i) * e + py.dst,
+                src + ((z + k) * sizeX + x + i) * sizeY + y,
+                sizeof(float) * py.size
+            );
+}
+
+// initialization
+ChunkGrid::ChunkGrid(Generator& generator, size_t chunkSize, size_t halo, float step) : m_generator(generator) {
+    m_chunkSize = chunkSize;
+    m_halo = halo < chunkSize ? halo : chunkSize;
+    m_step = step;
+    m_generated = 0;
+}
+ChunkGrid::~ChunkGrid() {}
+
+// Chunks
+const std::vector<float>& ChunkGrid::getInterior(const ChunkCoord& chunk) {
+    static const std::vector<float> failed;
+
+    auto r = m_chunks.find(chunk_key(chunk));
+    if (r != m_chunks.end()) return r->second;
+
+    AxisPart all = axis_part(0, m_chunkSize, 0);
+    SampleBox box = chunk_box(chunk, m_chunkSize * m_step, m_step, all, all, all);
+    NoiseBuffer b = m_generator.getBoxes(&box, 1);
+    if (!b.size) return failed;
+    m_generated += b.size;
+
+    return m_chunks.emplace(chunk_key(chunk), std::vector<float>(b.data, b.data + b.size)).first->second;
+}
+
+bool ChunkGrid::getChunk(const ChunkCoord& chunk, float* out) {
+    const size_t n = m_chunkSize;
+    const size_t h = m_halo;
+    const size_t e = n + 2 * h;
+    float span = n * m_step;
+
+    // Parts of resident chunks are copied, missing ones are generated together in one dispatch
+    std::vector<SampleBox> boxes;
+    std::vector<int> missing;
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                AxisPart px = axis_part(dx, n, h);
+                AxisPart py = axis_part(dy, n, h);
+                AxisPart pz = axis_part(dz, n, h);
+                if (!px.size || !py.size || !pz.size) continue;
+
+                ChunkCoord owner = { chunk.x + dx, chunk.y + dy, chunk.z + dz };
+                auto r = m_chunks.find(chunk_key(owner));
+                if (r != m_chunks.end()) {
+                    copy_part(r->second.data(), n, n, px.src, py.src, pz.src, px, py, pz, out, e);
+                } else {
+                    boxes.push_back(chunk_box(owner, span, m_step, px, py, pz));
+                    missing.push_back(((dz + 1) * 3 + dx + 1) * 3 + dy + 1);
+                }
+            }
+        }
+    }
+    if (boxes.empty()) return true;
+
+    NoiseBuffer b = m_generator.getBoxes(boxes.data(), boxes.size());
+    if (!b.size) return false;
+    m_generated += b.size;
+
+    const float* src = b.data;
+    for (size_t i = 0; i < boxes.size(); i++) {
+        int dz = missing[i] / 9 - 1, dx = missing[i] / 3 % 3 - 1, dy = missing[i] % 3 - 1;
+        AxisPart px = axis_part(dx, n, h);
+        AxisPart py = axis_part(dy, n, h);
+        AxisPart pz = axis_part(dz, n, h);
+        copy_part(src, px.size, py.size, 0, 0, 0, px, py, pz, out, e);
+
+        // Keep generated interior, neighbours built later copy their border from it
+        if (!dx && !dy && !dz) m_chunks.emplace(chunk_key(chunk), std::vector<float>(src, src + n * n * n));
+        src += px.size * py.size * pz.size;
+    }
+    return true;
+}
+
+bool ChunkGrid::isResident(const ChunkCoord& chunk) const {
+    return m_chunks.count(chunk_key(chunk)) != 0;
+}
+void ChunkGrid::evict(const ChunkCoord& chunk) {
+    m_chunks.erase(chunk_key(chunk));
+}
+void ChunkGrid::clear() {
+    m_chunks.clear();
+}
+
+// Getters/Setters
+size_t ChunkGrid::getChunkSize() const {
+    return m_chunkSize;
+}
+size_t ChunkGrid::getHalo() const {
+    return m_halo;
+}
+size_t ChunkGrid::getGeneratedCount() const {
+    return m_generated;
+}
@@ -0,0 +1,87 @@
+// ChunkGrid.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef ChunkGrid_H
+#define ChunkGrid_H
+
+#include <cstdlib>
+#include <vector>
+#include <unordered_map>
+#include "Generator.h"
+
+//! \brief integer position of a chunk in the grid
+struct ChunkCoord {
+    int x;
+    int y;
+    int z;
+};
+
+/*! \brief Grid of cubic 3D chunks that shares borders between neighbours
+ * Only chunk interiors are kept. A chunk with halo copies every part held by a resident chunk,
+ * only the missing interior and border slabs are generated, together in one dispatch.
+ * Samples are always placed from the origin of the chunk that holds them, so copied and
+ * generated parts agree exactly. Cellular NoiseLookup is not supported
+ */
+class ChunkGrid {
+public:
+    /*! \brief Create chunk grid
+     * \param chunkSize samples along each side of a chunk interior
+     * \param halo border width added on each side by getChunk, at most chunkSize
+     * \param step distance between samples
+     */
+    ChunkGrid(Generator& generator, size_t chunkSize, size_t halo, float step = 1.0f);
+    ~ChunkGrid();
+
+    //! \brief Returns chunkSize^3 interior samples, generates the chunk if it is not resident. Empty if generation failed
+    const std::vector<float>& getInterior(const ChunkCoord& chunk);
+
+    /*! \brief Fills out with (chunkSize + 2 * halo)^3 samples of the chunk and its border
+     * Layout is the same as of Generator::getNoise(x, y, z). Returns false if generation failed,
+     * out is left unspecified then
+     */
+    bool getChunk(const ChunkCoord& chunk, float* out);
+
+    bool isResident(const ChunkCoord& chunk) const;
+    void evict(const ChunkCoord& chunk);
+    void clear();
+
+    size_t getChunkSize() const;
+    size_t getHalo() const;
+    //! \brief Returns number of samples generated so far, interiors and border slabs
+    size_t getGeneratedCount() const;
+
+protected:
+    Generator& m_generator;
+    size_t m_chunkSize;
+    size_t m_halo;
+    float m_step;
+    size_t m_generated;
+
+    std::unordered_map<unsigned long long, std::vector<float>> m_chunks;
+};
+
+#endif
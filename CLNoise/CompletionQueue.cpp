@@ -0,0 +1,172 @@
+// CompletionQueue.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#include "CompletionQueue.h"
+
+#if defined(__linux__) && !defined(CLNOISE_NO_EVENTFD)
+#include <sys/eventfd.h>
+#endif
+#if !defined(_WIN32)
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+struct CompletionTicket {
+    CompletionQueue* queue;
+    unsigned long long id;
+};
+
+// initialization
+CompletionQueue::CompletionQueue(Generator& generator) : m_generator(generator) {
+    m_fd[0] = m_fd[1] = -1;
+    m_lastId = 0;
+    m_running = 0;
+
+#if defined(__linux__) && !defined(CLNOISE_NO_EVENTFD)
+    m_fd[0] = m_fd[1] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+#if !defined(_WIN32)
+    if (m_fd[0] < 0 && pipe(m_fd) == 0) {
+        for (int i = 0; i < 2; i++) {
+            fcntl(m_fd[i], F_SETFL, fcntl(m_fd[i], F_GETFL) | O_NONBLOCK);
+            fcntl(m_fd[i], F_SETFD, FD_CLOEXEC);
+        }
+    }
+#endif
+}
+CompletionQueue::~CompletionQueue() {
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_idle.wait(lock, [this] { return m_running == 0; });
+    lock.unlock();
+
+#if !defined(_WIN32)
+    if (m_fd[0] >= 0) close(m_fd[0]);
+    if (m_fd[1] >= 0 && m_fd[1] != m_fd[0]) close(m_fd[1]);
+#endif
+}
+
+int CompletionQueue::getFd() const {
+    return m_fd[0];
+}
+
+// Generation
+unsigned long long CompletionQueue::submit(const Range& x) {
+    CompletionTicket* ticket = reserve();
+    unsigned long long id = ticket->id;
+    return m_generator.getNoiseAsync(x, complete, ticket) ? id : cancel(ticket);
+}
+unsigned long long CompletionQueue::submit(const Range& x, const Range& y) {
+    CompletionTicket* ticket = reserve();
+    unsigned long long id = ticket->id;
+    return m_generator.getNoiseAsync(x, y, complete, ticket) ? id : cancel(ticket);
+}
+unsigned long long CompletionQueue::submit(const Range& x, const Range& y, const Range& z) {
+    CompletionTicket* ticket = reserve();
+    unsigned long long id = ticket->id;
+    return m_generator.getNoiseAsync(x, y, z, complete, ticket) ? id : cancel(ticket);
+}
+unsigned long long CompletionQueue::submit(const Range& x, const Range& y, const Range& z, const Range& w) {
+    CompletionTicket* ticket = reserve();
+    unsigned long long id = ticket->id;
+    return m_generator.getNoiseAsync(x, y, z, w, complete, ticket) ? id : cancel(ticket);
+}
+
+size_t CompletionQueue::drain(std::vector<Completion>& completions) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    clearSignal();
+
+    size_t count = m_ready.size();
+    for (Completion& c : m_ready) completions.push_back(std::move(c));
+    m_ready.clear();
+
+    return count;
+}
+
+// Getters/Setters
+size_t CompletionQueue::getPending() const {
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_running + m_ready.size();
+}
+
+// Misc
+CompletionTicket* CompletionQueue::reserve() {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_running++;
+    return new CompletionTicket{ this, ++m_lastId };
+}
+unsigned long long CompletionQueue::cancel(CompletionTicket* ticket) {
+    delete ticket;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_running--;
+    m_idle.notify_all();
+    return 0;
+}
+
+// Called from an OpenCL runtime thread
+void CompletionQueue::complete(void* data, NoiseBuffer&& result) {
+    CompletionTicket* ticket = (CompletionTicket*)data;
+    CompletionQueue& queue = *ticket->queue;
+
+    {
+        std::lock_guard<std::mutex> lock(queue.m_lock);
+        queue.m_ready.push_back(Completion{ ticket->id, std::move(result) });
+        if (queue.m_ready.size() == 1) queue.signal(); // Descriptor stays readable until drained
+        queue.m_running--;
+        queue.m_idle.notify_all();
+    }
+
+    delete ticket;
+}
+
+// Descriptor, callers hold m_lock
+void CompletionQueue::signal() {
+#if !defined(_WIN32)
+    if (m_fd[1] < 0) return;
+
+    ssize_t written;
+    if (m_fd[1] == m_fd[0]) {
+        unsigned long long one = 1;
+        written = write(m_fd[1], &one, sizeof(one));
+    } else {
+        char one = 1;
+        written = write(m_fd[1], &one, sizeof(one));
+    }
+    (void)written;
+#endif
+}
+void CompletionQueue::clearSignal() {
+#if !defined(_WIN32)
+    if (m_fd[0] < 0) return;
+
+    char buffer[64];
+    if (m_fd[1] == m_fd[0]) {
+        ssize_t count = read(m_fd[0], buffer, sizeof(unsigned long long));
+        (void)count;
+    } else while (read(m_fd[0], buffer, sizeof(buffer)) > 0);
+#endif
+}
@@ -0,0 +1,98 @@
+// CompletionQueue.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef CompletionQueue_H
+#define CompletionQueue_H
+
+#include <cstdlib>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include "Generator.h"
+
+struct CompletionTicket;
+
+//! \brief finished request of a CompletionQueue
+struct Completion {
+    //! \brief id returned by submit
+    unsigned long long id;
+    //! \brief samples like getNoise, empty if generation failed
+    NoiseBuffer result;
+};
+
+/*! \brief signals finished generation through a file descriptor for event loops
+ * Requests are queued on the device without blocking. When one finishes, an eventfd (a pipe where eventfd is
+ * not available or CLNOISE_NO_EVENTFD is defined) becomes readable, so it can be watched by epoll, poll or select next to sockets.
+ * drain then moves every finished request out without blocking. No threads are created, results are
+ * collected by the completion callbacks of the OpenCL runtime
+ */
+class CompletionQueue {
+public:
+    CompletionQueue(Generator& generator);
+    //! \brief Waits for requests still running, results not drained are dropped
+    ~CompletionQueue();
+
+    //! \brief Descriptor that is readable while finished requests wait to be drained, -1 if none could be created
+    int getFd() const;
+
+    /*! \brief Starts generation like getNoise of generator, using its Noise and slice at the time of the call
+     * \return id reported by the Completion, 0 if nothing was started
+     */
+    unsigned long long submit(const Range& x);
+    unsigned long long submit(const Range& x, const Range& y);
+    unsigned long long submit(const Range& x, const Range& y, const Range& z);
+    unsigned long long submit(const Range& x, const Range& y, const Range& z, const Range& w);
+
+    /*! \brief Appends finished requests to completions and clears the descriptor, never blocks
+     * \return number of appended requests
+     */
+    size_t drain(std::vector<Completion>& completions);
+
+    // Getters/Setters
+    //! \brief Requests submitted but not drained yet
+    size_t getPending() const;
+
+protected:
+    Generator& m_generator;
+    int m_fd[2]; // read and write end, both the same eventfd if available
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_idle;
+    std::vector<Completion> m_ready;
+    unsigned long long m_lastId;
+    size_t m_running;
+
+private:
+    CompletionTicket* reserve();
+    unsigned long long cancel(CompletionTicket* ticket);
+    void signal();
+    void clearSignal();
+
+    static void complete(void* data, NoiseBuffer&& result);
+};
+
+#endif
@@ -0,0 +1,204 @@
+// CostModel.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#include "CostModel.h"
+
+#include <chrono>
+#include <algorithm>
+
+#define COST_REPEATS 3
+#define COST_LOOKUP_DEPTH 8
+
+NoiseBuffer get_line(Generator& generator, int dimensions, size_t samples) {
+    Range x(samples, 0.0f, 1.0f), one(1, 0.0f, 1.0f);
+
+    switch (dimensions) {
+    case 1:
+        return generator.getNoise(x);
+    case 2:
+        return generator.getNoise(x, one);
+    case 3:
+        return generator.getNoise(x, one, one);
+    default:
+        return generator.getNoise(x, one, one, one);
+    }
+}
+
+// initialization
+CostModel::CostModel(const Device& device) : m_generator(device) {
+    m_calibrated = false;
+    m_overhead = 0;
+    for (int d = 0; d < 4; d++) {
+        m_transfer[d] = 0;
+        for (int b = 0; b < BLOCK_COUNT; b++)
+            m_costs[d][b] = 0;
+    }
+}
+CostModel::~CostModel() {}
+
+// Calibration
+double CostModel::measure(Noise& noise, int dimensions, size_t samples) {
+    m_generator.setNoise(&noise);
+
+    // Best of several runs, first one also warms up the kernel
+    double best = -1;
+    for (int r = 0; r < COST_REPEATS; r++) {
+        auto start = std::chrono::steady_clock::now();
+        NoiseBuffer b = get_line(m_generator, dimensions, samples);
+        auto end = std::chrono::steady_clock::now();
+        if (!b.size) {
+            best = 0;
+            break;
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (best < 0 || ms < best) best = ms;
+    }
+
+    m_generator.setNoise(nullptr);
+    return best;
+}
+void CostModel::calibrate(size_t samples) {
+    if (samples == 0) samples = 1;
+
+    Noise noise;
+    noise.setNoiseType(NoiseType::Value);
+    m_overhead = measure(noise, 2, 1);
+
+    // WhiteNoise is mostly readback and copy, it is the transfer baseline of the other blocks
+    const NoiseType types[] = { NoiseType::Value, NoiseType::Perlin, NoiseType::Simplex, NoiseType::Cellular, NoiseType::Cellular, NoiseType::WhiteNoise };
+    for (int d = 1; d <= 4; d++) {
+        noise.setNoiseType(NoiseType::WhiteNoise);
+        m_transfer[d - 1] = std::max(0.0, measure(noise, d, samples) - m_overhead) * 1e6 / samples;
+
+        for (int b = Value; b < WhiteNoise; b++) {
+            noise.setNoiseType(types[b]);
+            noise.setCellularReturnType(b == CellularEdge ? CellularReturnType::Distance2 : CellularReturnType::CellValue);
+
+            double ms = measure(noise, d, samples);
+            m_costs[d - 1][b] = std::max(0.0, std::max(0.0, ms - m_overhead) * 1e6 / samples - m_transfer[d - 1]);
+        }
+        m_costs[d - 1][WhiteNoise] = 0;
+    }
+
+    // Perturb is measured as difference to plain Value noise, only 2D and 3D apply it
+    Perturb perturb;
+    perturb.setPerturbType(PerturbType::Single);
+    noise.setNoiseType(NoiseType::Value);
+    noise.setPerturb(&perturb);
+    for (int d = 2; d <= 3; d++) {
+        double ms = measure(noise, d, samples);
+        m_costs[d - 1][PerturbSingle] = std::max(0.0, std::max(0.0, ms - m_overhead) * 1e6 / samples - m_transfer[d - 1] - m_costs[d - 1][Value]);
+    }
+    noise.setPerturb(nullptr);
+
+    m_calibrated = true;
+}
+
+// Estimation, compute only, transfer is added once by getSampleCost
+double CostModel::lookupCost(const Noise& noise, int dimensions, int depth) const {
+    if (dimensions < 1 || dimensions > 4) return 0;
+    const double* costs = m_costs[dimensions - 1];
+
+    int octaves = 1;
+    switch (noise.getNoiseType()) {
+    case NoiseType::ValueFractal:
+    case NoiseType::PerlinFractal:
+    case NoiseType::SimplexFractal:
+        if (noise.getFractal()) octaves = std::max(1, noise.getFractal()->getOctaves());
+        break;
+    default:
+        break;
+    }
+
+    double cost = 0;
+    switch (noise.getNoiseType()) {
+    case NoiseType::Value:
+    case NoiseType::ValueFractal:
+        cost = costs[Value] * octaves;
+        break;
+    case NoiseType::Perlin:
+    case NoiseType::PerlinFractal:
+        cost = costs[Perlin] * octaves;
+        break;
+    case NoiseType::Simplex:
+    case NoiseType::SimplexFractal:
+        cost = costs[Simplex] * octaves;
+        break;
+    case NoiseType::Cellular:
+        switch (noise.getCellularReturnType()) {
+        case CellularReturnType::CellValue:
+        case CellularReturnType::Distance:
+            cost = costs[Cellular];
+            break;
+        case CellularReturnType::NoiseLookup:
+            cost = costs[Cellular];
+            if (noise.getCellularNoiseLookup() && depth < COST_LOOKUP_DEPTH)
+                cost += lookupCost(*noise.getCellularNoiseLookup(), dimensions, depth + 1);
+            break;
+        default:
+            cost = costs[CellularEdge];
+            break;
+        }
+        break;
+    case NoiseType::WhiteNoise:
+        cost = costs[WhiteNoise];
+        break;
+    }
+
+    // Only 2D and 3D kernels apply perturb, lookup kernels apply it on every level
+    const Perturb* p = noise.getPerturb();
+    if (p && (dimensions == 2 || dimensions == 3)) {
+        switch (p->getPerturbType()) {
+        case PerturbType::Single:
+            cost += costs[PerturbSingle];
+            break;
+        case PerturbType::Fractal:
+            cost += costs[PerturbSingle] * (p->getFractal() ? std::max(1, p->getFractal()->getOctaves()) : 1);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return cost;
+}
+double CostModel::getSampleCost(const Noise& noise, int dimensions) const {
+    if (dimensions < 1 || dimensions > 4) return 0;
+    return m_transfer[dimensions - 1] + lookupCost(noise, dimensions, 0);
+}
+double CostModel::estimate(const Noise& noise, int dimensions, size_t samples) const {
+    return m_overhead + getSampleCost(noise, dimensions) * samples * 1e-6;
+}
+
+// Getters/Setters
+bool CostModel::isCalibrated() const {
+    return m_calibrated;
+}
+double CostModel::getDispatchOverhead() const {
+    return m_overhead;
+}
@@ -0,0 +1,77 @@
+// CostModel.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef CostModel_H
+#define CostModel_H
+
+#include <cstdlib>
+#include "Generator.h"
+
+/*! \brief estimates generation time of a Noise configuration on one device
+ * Per-sample costs of single octave Value, Perlin, Simplex, Cellular and WhiteNoise,
+ * of perturb and of dispatch overhead are measured by calibrate(). Readback and copy of
+ * a sample is measured with WhiteNoise, whose compute is negligible, and kept apart from
+ * the compute costs. Fractals cost one base sample of compute per octave, NoiseLookup adds
+ * the compute of the lookup Noise, transfer is counted once per sample
+ */
+class CostModel {
+public:
+    //! \brief Create cost model for device, call calibrate() before estimating
+    CostModel(const Device& device);
+    ~CostModel();
+
+    /*! \brief Measures building blocks on the device
+     * Takes a few dispatches of samples size per block, a fraction of a second on most devices
+     */
+    void calibrate(size_t samples = 1 << 18);
+    bool isCalibrated() const;
+
+    //! \brief Returns expected time of one sample in nanoseconds, 0 if configuration is not supported
+    double getSampleCost(const Noise& noise, int dimensions) const;
+    //! \brief Returns expected time in milliseconds of a getNoise request with given number of samples
+    double estimate(const Noise& noise, int dimensions, size_t samples) const;
+
+    // Getters/Setters
+    //! \brief Time in milliseconds of a dispatch regardless of its size
+    double getDispatchOverhead() const;
+
+protected:
+    // Building blocks, index of NoiseType base types
+    enum Block { Value, Perlin, Simplex, Cellular, CellularEdge, WhiteNoise, PerturbSingle, BLOCK_COUNT };
+
+    Generator m_generator;
+    bool m_calibrated;
+    double m_overhead;                // ms per dispatch
+    double m_transfer[4];             // ns per sample of readback and copy, [dimensions - 1]
+    double m_costs[4][BLOCK_COUNT];   // ns per sample, [dimensions - 1][block]
+
+private:
+    double measure(Noise& noise, int dimensions, size_t samples);
+    double lookupCost(const Noise& noise, int dimensions, int depth) const;
+};
+
+#endif
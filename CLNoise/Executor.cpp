@@ -0,0 +1,149 @@
+// Executor.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#include "Executor.h"
+
+#include <memory>
+
+// Executor
+std::atomic<Executor*> g_executor(nullptr);
+std::once_flag g_executorOnce;
+std::unique_ptr<WorkStealingPool> g_executorPool;
+
+Executor& Executor::getDefault() {
+    Executor* executor = g_executor.load();
+    if (executor) return *executor;
+
+    std::call_once(g_executorOnce, [] { g_executorPool.reset(new WorkStealingPool()); });
+    return *g_executorPool;
+}
+void Executor::setDefault(Executor* executor) {
+    g_executor.store(executor);
+}
+
+// InlineExecutor
+void InlineExecutor::submit(Task task) {
+    task();
+}
+size_t InlineExecutor::getConcurrency() const {
+    return 1;
+}
+
+// FunctionExecutor
+FunctionExecutor::FunctionExecutor(Submit submit, size_t concurrency) {
+    m_submit = submit;
+    m_concurrency = concurrency ? concurrency : 1;
+}
+void FunctionExecutor::submit(Task task) {
+    m_submit(std::move(task));
+}
+size_t FunctionExecutor::getConcurrency() const {
+    return m_concurrency;
+}
+
+// WorkStealingPool
+thread_local WorkStealingPool* t_pool = nullptr;
+thread_local size_t t_worker = 0;
+
+WorkStealingPool::WorkStealingPool(size_t threads) : m_next(0) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    m_pending = 0;
+    m_stop = false;
+    for (size_t i = 0; i < threads; i++) m_workers.push_back(new Worker);
+    for (size_t i = 0; i < threads; i++) m_threads.emplace_back([this, i] { work(i); });
+}
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepLock);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (size_t i = 0; i < m_threads.size(); i++) m_threads[i].join();
+    for (size_t i = 0; i < m_workers.size(); i++) delete m_workers[i];
+}
+
+void WorkStealingPool::submit(Task task) {
+    // Own deque when called from a task of this pool, otherwise round robin
+    size_t index = t_pool == this ? t_worker : m_next++ % m_workers.size();
+    {
+        std::lock_guard<std::mutex> lock(m_workers[index]->lock);
+        m_workers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sleepLock);
+        m_pending++;
+    }
+    m_wake.notify_one();
+}
+size_t WorkStealingPool::getConcurrency() const {
+    return m_workers.size();
+}
+
+bool WorkStealingPool::take(size_t index, Task& task) {
+    {
+        Worker& own = *m_workers[index];
+        std::lock_guard<std::mutex> lock(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < m_workers.size(); i++) {
+        Worker& other = *m_workers[(index + i) % m_workers.size()];
+        std::lock_guard<std::mutex> lock(other.lock);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+void WorkStealingPool::work(size_t index) {
+    t_pool = this;
+    t_worker = index;
+
+    for (;;) {
+        {
+            // Claim a task before looking for it, so it is never missed
+            std::unique_lock<std::mutex> lock(m_sleepLock);
+            m_wake.wait(lock, [this] { return m_pending > 0 || m_stop; });
+            if (m_pending == 0) return;
+            m_pending--;
+        }
+
+        Task task;
+        while (!take(index, task)) std::this_thread::yield();
+        task();
+    }
+}
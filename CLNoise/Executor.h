@@ -0,0 +1,120 @@
+// Executor.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef Executor_H
+#define Executor_H
+
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+
+/*! \brief runs host side work of the library
+ * Library code never creates threads itself, it submits tasks to an Executor. Tasks never wait on
+ * other tasks, so any scheduler works, including one running tasks on the submitting thread
+ */
+class Executor {
+public:
+    typedef std::function<void()> Task;
+
+    virtual ~Executor() {}
+
+    //! \brief Runs task once, at any time and on any thread
+    virtual void submit(Task task) = 0;
+    //! \brief Number of tasks that may run at once
+    virtual size_t getConcurrency() const = 0;
+
+    /*! \brief Executor used when none is set
+     * A WorkStealingPool with one thread per core, created on first use
+     */
+    static Executor& getDefault();
+    //! \brief Replaces default executor, nullptr restores built-in one. Executor has to outlive its use
+    static void setDefault(Executor* executor);
+};
+
+//! \brief runs every task immediately on the submitting thread
+class InlineExecutor : public Executor {
+public:
+    void submit(Task task) override;
+    size_t getConcurrency() const override;
+};
+
+/*! \brief forwards tasks to the job system of the application
+ * e.g. FunctionExecutor([&](Executor::Task t) { jobs.push(std::move(t)); }, jobs.threads())
+ */
+class FunctionExecutor : public Executor {
+public:
+    typedef std::function<void(Task)> Submit;
+
+    FunctionExecutor(Submit submit, size_t concurrency);
+
+    void submit(Task task) override;
+    size_t getConcurrency() const override;
+
+protected:
+    Submit m_submit;
+    size_t m_concurrency;
+};
+
+/*! \brief fixed set of threads with one deque each
+ * Tasks submitted from a pool thread go to its own deque and run newest first, idle threads
+ * steal oldest tasks of others. Destructor runs remaining tasks before joining
+ */
+class WorkStealingPool : public Executor {
+public:
+    //! \brief Create pool, 0 threads uses one per core
+    WorkStealingPool(size_t threads = 0);
+    ~WorkStealingPool();
+
+    void submit(Task task) override;
+    size_t getConcurrency() const override;
+
+protected:
+    struct Worker {
+        std::deque<Task> tasks;
+        std::mutex lock;
+    };
+
+    std::vector<Worker*> m_workers;
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t> m_next;
+
+    std::mutex m_sleepLock;
+    std::condition_variable m_wake;
+    size_t m_pending;
+    bool m_stop;
+
+private:
+    void work(size_t index);
+    bool take(size_t index, Task& task);
+};
+
+#endif
@@ -30,40 +30,89 @@
 
 #include <math.h>
 #include <assert.h>
+#include <string.h>
 #include <random>
 #include <vector>
 #include <algorithm>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
 
 #define FN_CELLULAR_INDEX_MAX 3
+#define FN_PERTURB_COARSE_SAMPLES 16.0f
+#define FN_PERTURB_FACTOR_MAX 16
 
 // NoiseBuffer
 NoiseBuffer::NoiseBuffer(size_t size, float* data) {
     this->size = size;
     this->data = data;
 }
+NoiseBuffer::NoiseBuffer(NoiseBuffer&& other) {
+    size = other.size;
+    data = other.data;
+    other.size = 0;
+    other.data = nullptr;
+}
+NoiseBuffer& NoiseBuffer::operator= (NoiseBuffer&& other) {
+    if (this != &other) {
+        if (size) delete[] data;
+        size = other.size;
+        data = other.data;
+        other.size = 0;
+        other.data = nullptr;
+    }
+    return *this;
+}
 NoiseBuffer::~NoiseBuffer() {
     if (size) delete[] data;
 }
 
+// Chunk cache state
+struct ChunkEntry {
+    int x, y, z;
+    int slot;
+    std::list<unsigned long long>::iterator lru;
+};
+struct ChunkCacheState {
+    ChunkStore* m_store;
+    size_t m_chunkSize;
+    size_t m_slots;
+    int m_dimensions;
+    float m_step;
+    unsigned long long m_fingerprint;
+
+    std::list<unsigned long long> m_lru;
+    std::unordered_map<unsigned long long, ChunkEntry> m_resident;
+    std::vector<int> m_freeSlots;
+    std::vector<int> m_table; // Host copy of device table, 4 ints per entry
+};
+
 // Generator::impl
 class Generator::impl {
 public:
     KernelAdapter* m_kernelAdapter;
+    ChunkCacheState* m_chunks;
     Snapshot createSnapshot(const Noise* noise) const;
     std::vector<Snapshot> buildSnapshotChain() const;
+    bool buildBiomes(const std::vector<Noise*>& biomes, std::vector<Snapshot>& params) const;
 
     impl(const Generator* generator) {
         m_generator = generator;
         m_kernelAdapter = nullptr;
+        m_chunks = nullptr;
     }
     ~impl() {
+        if (m_chunks) {
+            m_kernelAdapter->CACHE_Release(m_chunks->m_store);
+            delete m_chunks;
+        }
         if (m_kernelAdapter) delete m_kernelAdapter;
     }
 private:
     const Generator* m_generator;
 };
 Snapshot Generator::impl::createSnapshot(const Noise* noise) const {
-    Snapshot snap;
+    Snapshot snap = {};
 
     if (noise) {
         const Noise& n = *noise;
@@ -124,6 +173,17 @@ std::vector<Snapshot> Generator::impl::buildSnapshotChain() const {
     return params;
 }
 
+bool Generator::impl::buildBiomes(const std::vector<Noise*>& biomes, std::vector<Snapshot>& params) const {
+    if (biomes.empty() || biomes.size() > 256) return false;
+
+    for (size_t i = 0; i < biomes.size(); i++) {
+        if (!biomes[i]) return false;
+        if (biomes[i]->getNoiseType() == NoiseType::Cellular && biomes[i]->getCellularReturnType() == CellularReturnType::NoiseLookup) return false;
+        params.push_back(createSnapshot(biomes[i]));
+    }
+
+    return true;
+}
 // Generator
 // initialization
 Generator::Generator(const Device& device) : rimpl(*(new impl(this))){
@@ -132,6 +192,11 @@ Generator::Generator(const Device& device) : rimpl(*(new impl(this))){
     m_buffer = nullptr;
     m_bufSize = 0;
 
+    m_sliceFirst = 0;
+    m_sliceCount = 0;
+
+    m_executor = nullptr;
+
     prepareDevice(device);
 };
 Generator::~Generator() {
@@ -140,6 +205,20 @@ Generator::~Generator() {
 
 // Generation
 template <typename T1, typename T2>
+NoiseBuffer Get1D(float* m_buffer, size_t m_bufSize, KernelAdapter* m_kernelAdapter, Snapshot snapshot, const T1& x, void (KernelAdapter::*nf) (Snapshot, size_t, T2, T2, float*)) {
+    (m_kernelAdapter->*nf)(
+        snapshot,
+
+        x.size,
+        x.step,
+        x.offset,
+
+        m_buffer
+    );
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+template <typename T1, typename T2>
 NoiseBuffer Get2D(float* m_buffer, size_t m_bufSize, KernelAdapter* m_kernelAdapter, Snapshot snapshot, const T1& x, const T1& y, void (KernelAdapter::*nf) (Snapshot, size_t, size_t, T2, T2, T2, T2, float*)) {
     (m_kernelAdapter->*nf)(
         snapshot,
@@ -181,12 +260,53 @@ NoiseBuffer Get4D(float* m_buffer, size_t m_bufSize, KernelAdapter* m_kernelAdap
 
     return NoiseBuffer(m_bufSize, m_buffer);
 }
-bool Generator::prepare(const size_t size) {
+bool Generator::prepare(const size_t size, bool sliced) {
     if (size == 0) return false;
     if (!rimpl.m_kernelAdapter) return false;
-    prepareBuffer(size);
+
+    size_t first = 0, count = size;
+    if (sliced && m_sliceCount) {
+        if (m_sliceFirst >= size) return false;
+        first = m_sliceFirst;
+        count = std::min(m_sliceCount, size - first);
+    }
+    rimpl.m_kernelAdapter->setSlice(first, count);
+
+    prepareBuffer(count);
     return true;
 }
+// 1D
+NoiseBuffer Generator::getNoise(const Range& x) {
+    if (!m_noise) return NoiseBuffer(0, nullptr);
+
+    void (KernelAdapter::*nf) (Snapshot, size_t, float, float, float*) = nullptr;
+    switch(m_noise->getNoiseType()) {
+    case NoiseType::Perlin:
+        nf = &KernelAdapter::GEN_Perlin1;
+        break;
+    case NoiseType::PerlinFractal:
+        nf = &KernelAdapter::GEN_PerlinFractal1;
+        break;
+    case NoiseType::Simplex:
+        nf = &KernelAdapter::GEN_Simplex1;
+        break;
+    case NoiseType::SimplexFractal:
+        nf = &KernelAdapter::GEN_SimplexFractal1;
+        break;
+    case NoiseType::Value:
+        nf = &KernelAdapter::GEN_Value1;
+        break;
+    case NoiseType::ValueFractal:
+        nf = &KernelAdapter::GEN_ValueFractal1;
+        break;
+    default:
+        return NoiseBuffer(0, nullptr);
+    }
+    if (!prepare(x.size)) return NoiseBuffer(0, nullptr);
+
+    return Get1D(m_buffer, m_bufSize, rimpl.m_kernelAdapter, rimpl.createSnapshot(m_noise), x, nf);
+}
+
 // 2D
 NoiseBuffer Generator::getNoise(const Range& x, const Range& y) {
     if (m_noise && !prepare(x.size * y.size)) return NoiseBuffer(0, nullptr);
@@ -195,7 +315,7 @@ NoiseBuffer Generator::getNoise(const Range& x, const Range& y) {
     switch(m_noise->getNoiseType()) {
     case NoiseType::Cellular:
         if (m_noise->getCellularReturnType() != CellularReturnType::NoiseLookup) {
-            nf = KernelAdapter::GEN_Cellular2;
+            nf = &KernelAdapter::GEN_Cellular2;
         } else {
             std::vector<Snapshot> chain = rimpl.buildSnapshotChain();
 
@@ -213,25 +333,25 @@ NoiseBuffer Generator::getNoise(const Range& x, const Range& y) {
         }
         break;
     case NoiseType::Perlin:
-        nf = KernelAdapter::GEN_Perlin2;
+        nf = &KernelAdapter::GEN_Perlin2;
         break;
     case NoiseType::PerlinFractal:
-        nf = KernelAdapter::GEN_PerlinFractal2;
+        nf = &KernelAdapter::GEN_PerlinFractal2;
         break;
     case NoiseType::Simplex:
-        nf = KernelAdapter::GEN_Simplex2;
+        nf = &KernelAdapter::GEN_Simplex2;
         break;
     case NoiseType::SimplexFractal:
-        nf = KernelAdapter::GEN_SimplexFractal2;
+        nf = &KernelAdapter::GEN_SimplexFractal2;
         break;
     case NoiseType::Value:
-        nf = KernelAdapter::GEN_Value2;
+        nf = &KernelAdapter::GEN_Value2;
         break;
     case NoiseType::ValueFractal:
-        nf = KernelAdapter::GEN_ValueFractal2;
+        nf = &KernelAdapter::GEN_ValueFractal2;
         break;
     case NoiseType::WhiteNoise:
-        nf = KernelAdapter::GEN_WhiteNoise2;
+        nf = &KernelAdapter::GEN_WhiteNoise2;
         break;
     }
     return Get2D(m_buffer, m_bufSize, rimpl.m_kernelAdapter, rimpl.createSnapshot(m_noise), x, y, nf);
@@ -259,29 +379,29 @@ NoiseBuffer Generator::getNoise(const Range& x, const Range& y, const Range& z)
 
             return NoiseBuffer(m_bufSize, m_buffer);
         } else {
-            nf = KernelAdapter::GEN_Cellular3;
+            nf = &KernelAdapter::GEN_Cellular3;
         }
         break;
     case NoiseType::Perlin:
-        nf = KernelAdapter::GEN_Perlin3;
+        nf = &KernelAdapter::GEN_Perlin3;
         break;
     case NoiseType::PerlinFractal:
-        nf = KernelAdapter::GEN_PerlinFractal3;
+        nf = &KernelAdapter::GEN_PerlinFractal3;
         break;
     case NoiseType::Simplex:
-        nf = KernelAdapter::GEN_Simplex3;
+        nf = &KernelAdapter::GEN_Simplex3;
         break;
     case NoiseType::SimplexFractal:
-        nf = KernelAdapter::GEN_SimplexFractal3;
+        nf = &KernelAdapter::GEN_SimplexFractal3;
         break;
     case NoiseType::Value:
-        nf = KernelAdapter::GEN_Value3;
+        nf = &KernelAdapter::GEN_Value3;
         break;
     case NoiseType::ValueFractal:
-        nf = KernelAdapter::GEN_ValueFractal3;
+        nf = &KernelAdapter::GEN_ValueFractal3;
         break;
     case NoiseType::WhiteNoise:
-        nf = KernelAdapter::GEN_WhiteNoise3;
+        nf = &KernelAdapter::GEN_WhiteNoise3;
         break;
     }
 
@@ -290,15 +410,15 @@ NoiseBuffer Generator::getNoise(const Range& x, const Range& y, const Range& z)
 
 // 4D
 NoiseBuffer Generator::getNoise(const Range& x, const Range& y, const Range& z, const Range& w) {
-    if (m_noise && !prepare(x.size * y.size * z.size)) return NoiseBuffer(0, nullptr);
+    if (m_noise && !prepare(x.size * y.size * z.size * w.size)) return NoiseBuffer(0, nullptr);
 
     void (KernelAdapter::*nf) (Snapshot, size_t, size_t, size_t, size_t, float, float, float, float, float, float, float, float, float*) = nullptr;
     switch(m_noise->getNoiseType()) {
     case NoiseType::Simplex:
-        nf = KernelAdapter::GEN_Simplex4;
+        nf = &KernelAdapter::GEN_Simplex4;
         break;
     case NoiseType::WhiteNoise:
-        nf = KernelAdapter::GEN_WhiteNoise4;
+        nf = &KernelAdapter::GEN_WhiteNoise4;
         break;
     default:
         return NoiseBuffer(0, nullptr);
@@ -307,6 +427,769 @@ NoiseBuffer Generator::getNoise(const Range& x, const Range& y, const Range& z,
     return Get4D(m_buffer, m_bufSize, rimpl.m_kernelAdapter, rimpl.createSnapshot(m_noise), x, y, z, w, nf);
 }
 
+// Octaves
+bool octave_noise(const Noise* noise, int first, int last) {
+    if (!noise || first < 0 || last <= first) return false;
+
+    NoiseType type = noise->getNoiseType();
+    return type == NoiseType::ValueFractal || type == NoiseType::PerlinFractal || type == NoiseType::SimplexFractal;
+}
+bool Generator::addOctaves(const Range& x, const Range& y, int first, int last, float* result) {
+    if (!octave_noise(m_noise, first, last) || !result || !rimpl.m_kernelAdapter) return false;
+    if (x.size * y.size == 0) return false;
+
+    rimpl.m_kernelAdapter->GEN_Octaves2(
+        rimpl.createSnapshot(m_noise),
+        first, last,
+
+        x.size, y.size,
+        x.step, y.step,
+        x.offset, y.offset,
+
+        result
+    );
+
+    return true;
+}
+bool Generator::addOctaves(const Range& x, const Range& y, const Range& z, int first, int last, float* result) {
+    if (!octave_noise(m_noise, first, last) || !result || !rimpl.m_kernelAdapter) return false;
+    if (x.size * y.size * z.size == 0) return false;
+
+    rimpl.m_kernelAdapter->GEN_Octaves3(
+        rimpl.createSnapshot(m_noise),
+        first, last,
+
+        x.size, y.size, z.size,
+        x.step, y.step, z.step,
+        x.offset, y.offset, z.offset,
+
+        result
+    );
+
+    return true;
+}
+
+bool lookup_noise(const Noise* noise) {
+    return noise->getNoiseType() == NoiseType::Cellular && noise->getCellularReturnType() == CellularReturnType::NoiseLookup;
+}
+
+// Selection
+std::vector<float> Generator::getPercentiles(const Range& x, const Range& y, const std::vector<float>& fractions) {
+    std::vector<float> thresholds(fractions.size());
+    if (!m_noise || lookup_noise(m_noise) || !rimpl.m_kernelAdapter || x.size * y.size == 0 || fractions.empty()) return std::vector<float>();
+
+    rimpl.m_kernelAdapter->SEL_Select2(
+        rimpl.createSnapshot(m_noise),
+
+        x.size, y.size,
+        x.step, y.step,
+        x.offset, y.offset,
+
+        const_cast<float*>(fractions.data()), fractions.size(),
+        thresholds.data(),
+        nullptr
+    );
+
+    return thresholds;
+}
+std::vector<float> Generator::getPercentiles(const Range& x, const Range& y, const Range& z, const std::vector<float>& fractions) {
+    std::vector<float> thresholds(fractions.size());
+    if (!m_noise || lookup_noise(m_noise) || !rimpl.m_kernelAdapter || x.size * y.size * z.size == 0 || fractions.empty()) return std::vector<float>();
+
+    rimpl.m_kernelAdapter->SEL_Select3(
+        rimpl.createSnapshot(m_noise),
+
+        x.size, y.size, z.size,
+        x.step, y.step, z.step,
+        x.offset, y.offset, z.offset,
+
+        const_cast<float*>(fractions.data()), fractions.size(),
+        thresholds.data(),
+        nullptr
+    );
+
+    return thresholds;
+}
+std::vector<unsigned char> Generator::getMask(const Range& x, const Range& y, float fraction, float* threshold) {
+    std::vector<unsigned char> mask;
+    if (!m_noise || lookup_noise(m_noise) || !rimpl.m_kernelAdapter || x.size * y.size == 0) return mask;
+
+    float value;
+    mask.resize(x.size * y.size);
+    rimpl.m_kernelAdapter->SEL_Select2(
+        rimpl.createSnapshot(m_noise),
+
+        x.size, y.size,
+        x.step, y.step,
+        x.offset, y.offset,
+
+        &fraction, 1,
+        &value,
+        mask.data()
+    );
+
+    if (threshold) *threshold = value;
+    return mask;
+}
+std::vector<unsigned char> Generator::getMask(const Range& x, const Range& y, const Range& z, float fraction, float* threshold) {
+    std::vector<unsigned char> mask;
+    if (!m_noise || lookup_noise(m_noise) || !rimpl.m_kernelAdapter || x.size * y.size * z.size == 0) return mask;
+
+    float value;
+    mask.resize(x.size * y.size * z.size);
+    rimpl.m_kernelAdapter->SEL_Select3(
+        rimpl.createSnapshot(m_noise),
+
+        x.size, y.size, z.size,
+        x.step, y.step, z.step,
+        x.offset, y.offset, z.offset,
+
+        &fraction, 1,
+        &value,
+        mask.data()
+    );
+
+    if (threshold) *threshold = value;
+    return mask;
+}
+
+// Block compression
+std::vector<unsigned char> Generator::getBC4(const Range& x, const Range& y, float low, float high, int quality) {
+    std::vector<unsigned char> blocks;
+    if (!m_noise || lookup_noise(m_noise) || !rimpl.m_kernelAdapter || x.size * y.size == 0) return blocks;
+
+    blocks.resize(8 * ((x.size + 3) / 4) * ((y.size + 3) / 4));
+    rimpl.m_kernelAdapter->GEN_BC4(
+        rimpl.createSnapshot(m_noise),
+
+        x.size, y.size,
+        x.step, y.step,
+        x.offset, y.offset,
+
+        low, high,
+        quality,
+
+        blocks.data()
+    );
+
+    return blocks;
+}
+std::vector<unsigned char> Generator::getBC5(const Range& x, const Range& y, const Noise& green, float low, float high, int quality) {
+    std::vector<unsigned char> blocks;
+    if (!m_noise || lookup_noise(m_noise) || lookup_noise(&green) || !rimpl.m_kernelAdapter || x.size * y.size == 0) return blocks;
+
+    blocks.resize(16 * ((x.size + 3) / 4) * ((y.size + 3) / 4));
+    rimpl.m_kernelAdapter->GEN_BC5(
+        rimpl.createSnapshot(m_noise), rimpl.createSnapshot(&green),
+
+        x.size, y.size,
+        x.step, y.step,
+        x.offset, y.offset,
+
+        low, high,
+        quality,
+
+        blocks.data()
+    );
+
+    return blocks;
+}
+
+// Axis grids
+NoiseBuffer Generator::getGrid(const std::vector<float>& x, const std::vector<float>& y) {
+    if (!m_noise) return NoiseBuffer(0, nullptr);
+    if (m_noise->getNoiseType() == NoiseType::Cellular && m_noise->getCellularReturnType() == CellularReturnType::NoiseLookup) return NoiseBuffer(0, nullptr);
+    if (!prepare(x.size() * y.size(), false)) return NoiseBuffer(0, nullptr);
+
+    std::vector<float> axes(x);
+    axes.insert(axes.end(), y.begin(), y.end());
+
+    rimpl.m_kernelAdapter->GEN_Grid2(rimpl.createSnapshot(m_noise), x.size(), y.size(), axes.data(), m_buffer);
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+NoiseBuffer Generator::getGrid(const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z) {
+    if (!m_noise) return NoiseBuffer(0, nullptr);
+    if (m_noise->getNoiseType() == NoiseType::Cellular && m_noise->getCellularReturnType() == CellularReturnType::NoiseLookup) return NoiseBuffer(0, nullptr);
+    if (!prepare(x.size() * y.size() * z.size(), false)) return NoiseBuffer(0, nullptr);
+
+    std::vector<float> axes(x);
+    axes.insert(axes.end(), y.begin(), y.end());
+    axes.insert(axes.end(), z.begin(), z.end());
+
+    rimpl.m_kernelAdapter->GEN_Grid3(rimpl.createSnapshot(m_noise), x.size(), y.size(), z.size(), axes.data(), m_buffer);
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+
+// Levels
+std::vector<NoiseBuffer> Generator::getLevels(const Range& x, const Range& y, size_t levels) {
+    std::vector<NoiseBuffer> result;
+    if (!m_noise || !rimpl.m_kernelAdapter) return result;
+    if (m_noise->getNoiseType() == NoiseType::Cellular && m_noise->getCellularReturnType() == CellularReturnType::NoiseLookup) return result;
+    if (x.size * y.size == 0) return result;
+
+    size_t first = m_sliceFirst, count = m_sliceCount;
+    setSlice(0, 0);
+    result.reserve(levels + 1);
+    result.push_back(getNoise(x, y));
+    setSlice(first, count);
+
+    if (!result.back().size) return std::vector<NoiseBuffer>();
+    if (!levels) return result;
+
+    // Every level is allocated before dispatch, refinement keeps the previous level on device
+    std::vector<float*> buffers;
+    Range fx = x, fy = y;
+    for (size_t l = 0; l < levels; l++) {
+        fx.size = (fx.size - 1) * 2 + 1;
+        fy.size = (fy.size - 1) * 2 + 1;
+        if (!prepare(fx.size * fy.size, false)) return std::vector<NoiseBuffer>();
+        result.push_back(NoiseBuffer(m_bufSize, m_buffer));
+        buffers.push_back(m_buffer);
+    }
+
+    rimpl.m_kernelAdapter->GEN_Levels2(
+        rimpl.createSnapshot(m_noise),
+        result[0].data,
+
+        x.size, y.size,
+        x.step, y.step,
+        x.offset, y.offset,
+
+        levels, buffers.data()
+    );
+
+    return result;
+}
+std::vector<NoiseBuffer> Generator::getLevels(const Range& x, const Range& y, const Range& z, size_t levels) {
+    std::vector<NoiseBuffer> result;
+    if (!m_noise || !rimpl.m_kernelAdapter) return result;
+    if (m_noise->getNoiseType() == NoiseType::Cellular && m_noise->getCellularReturnType() == CellularReturnType::NoiseLookup) return result;
+    if (x.size * y.size * z.size == 0) return result;
+
+    size_t first = m_sliceFirst, count = m_sliceCount;
+    setSlice(0, 0);
+    result.reserve(levels + 1);
+    result.push_back(getNoise(x, y, z));
+    setSlice(first, count);
+
+    if (!result.back().size) return std::vector<NoiseBuffer>();
+    if (!levels) return result;
+
+    // Every level is allocated before dispatch, refinement keeps the previous level on device
+    std::vector<float*> buffers;
+    Range fx = x, fy = y, fz = z;
+    for (size_t l = 0; l < levels; l++) {
+        fx.size = (fx.size - 1) * 2 + 1;
+        fy.size = (fy.size - 1) * 2 + 1;
+        fz.size = (fz.size - 1) * 2 + 1;
+        if (!prepare(fx.size * fy.size * fz.size, false)) return std::vector<NoiseBuffer>();
+        result.push_back(NoiseBuffer(m_bufSize, m_buffer));
+        buffers.push_back(m_buffer);
+    }
+
+    rimpl.m_kernelAdapter->GEN_Levels3(
+        rimpl.createSnapshot(m_noise),
+        result[0].data,
+
+        x.size, y.size, z.size,
+        x.step, y.step, z.step,
+        x.offset, y.offset, z.offset,
+
+        levels, buffers.data()
+    );
+
+    return result;
+}
+
+// Worms
+NoiseBuffer Generator::carveWorms(const Range& x, const Range& y, const Range& z, const Noise& steering, const std::vector<float>& starts, size_t steps, float step, float turn, float depth) {
+    if (!m_noise || lookup_noise(m_noise) || lookup_noise(&steering)) return NoiseBuffer(0, nullptr);
+    if (!prepare(x.size * y.size * z.size, false)) return NoiseBuffer(0, nullptr);
+
+    std::vector<float> worms(starts.begin(), starts.begin() + starts.size() / 4 * 4);
+    rimpl.m_kernelAdapter->GEN_Worms3(
+        rimpl.createSnapshot(m_noise), rimpl.createSnapshot(&steering),
+
+        x.size, y.size, z.size,
+        x.step, y.step, z.step,
+        x.offset, y.offset, z.offset,
+
+        worms.data(), worms.size() / 4,
+        steps, step, turn,
+        depth,
+
+        m_buffer
+    );
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+
+// Brickmap
+Brickmap Generator::getBrickmap(const Range& x, const Range& y, const Range& z, float epsilon, float low, float high) {
+    Brickmap map;
+    map.bricksX = (x.size + Brickmap::size - 1) / Brickmap::size;
+    map.bricksY = (y.size + Brickmap::size - 1) / Brickmap::size;
+    map.bricksZ = (z.size + Brickmap::size - 1) / Brickmap::size;
+    if (!m_noise || lookup_noise(m_noise) || !rimpl.m_kernelAdapter || x.size * y.size * z.size == 0) {
+        map.bricksX = map.bricksY = map.bricksZ = 0;
+        return map;
+    }
+
+    size_t bricks = map.bricksX * map.bricksY * map.bricksZ;
+    std::vector<int> table(bricks * 2);
+    rimpl.m_kernelAdapter->GEN_Brickmap3(
+        rimpl.createSnapshot(m_noise),
+
+        x.size, y.size, z.size,
+        x.step, y.step, z.step,
+        x.offset, y.offset, z.offset,
+
+        low, high, epsilon,
+
+        table.data(),
+        map.pool
+    );
+
+    map.table.resize(bricks);
+    map.values.resize(bricks);
+    for (size_t b = 0; b < bricks; b++) {
+        map.table[b] = table[b * 2];
+        memcpy(&map.values[b], &table[b * 2 + 1], sizeof(float));
+    }
+
+    return map;
+}
+float Brickmap::getSample(size_t x, size_t y, size_t z) const {
+    size_t brick = ((z / size) * bricksX + x / size) * bricksY + y / size;
+    if (table[brick] < 0) return values[brick];
+
+    return pool[table[brick] * size * size * size + ((z % size) * size + x % size) * size + y % size];
+}
+
+// Chunk cache
+unsigned int chunk_hash(int x, int y, int z) { // Same as chunk_hash in Noise.cl
+    unsigned int h = (unsigned int)x * 0x8DA6B343u ^ (unsigned int)y * 0xD8163841u ^ (unsigned int)z * 0xCB1AB31Fu;
+    return h ^ (h >> 16);
+}
+unsigned long long chunk_key(int x, int y, int z) {
+    return ((unsigned long long)(x & 0x1FFFFF) << 42) | ((unsigned long long)(y & 0x1FFFFF) << 21) | (unsigned long long)(z & 0x1FFFFF);
+}
+void upload_chunk_table(KernelAdapter* adapter, ChunkCacheState& cache) {
+    std::fill(cache.m_table.begin(), cache.m_table.end(), -1);
+    size_t mask = cache.m_table.size() / 4 - 1;
+
+    for (auto& r : cache.m_resident) {
+        const ChunkEntry& e = r.second;
+        size_t h = chunk_hash(e.x, e.y, e.z) & mask;
+        while (cache.m_table[h * 4 + 3] >= 0) h = (h + 1) & mask;
+
+        cache.m_table[h * 4] = e.x;
+        cache.m_table[h * 4 + 1] = e.y;
+        cache.m_table[h * 4 + 2] = e.z;
+        cache.m_table[h * 4 + 3] = e.slot;
+    }
+
+    adapter->CACHE_Table(cache.m_store, cache.m_table.data());
+}
+void reset_chunk_cache(KernelAdapter* adapter, ChunkCacheState& cache, unsigned long long fingerprint) {
+    cache.m_lru.clear();
+    cache.m_resident.clear();
+    cache.m_freeSlots.clear();
+    for (size_t i = cache.m_slots; i > 0; i--) cache.m_freeSlots.push_back((int)i - 1);
+    cache.m_fingerprint = fingerprint;
+
+    upload_chunk_table(adapter, cache);
+}
+
+bool Generator::setChunkCache(size_t chunkSize, size_t slots, int dimensions, float step) {
+    if (rimpl.m_chunks) {
+        rimpl.m_kernelAdapter->CACHE_Release(rimpl.m_chunks->m_store);
+        delete rimpl.m_chunks;
+        rimpl.m_chunks = nullptr;
+    }
+    if (slots == 0) return true;
+    if (!rimpl.m_kernelAdapter || chunkSize < 2 || (dimensions != 2 && dimensions != 3) || step == 0.0f) return false;
+
+    size_t samples = dimensions == 2 ? chunkSize * chunkSize : chunkSize * chunkSize * chunkSize;
+    size_t entries = 2;
+    while (entries < 2 * slots) entries <<= 1;
+
+    ChunkCacheState* cache = new ChunkCacheState;
+    cache->m_store = rimpl.m_kernelAdapter->CACHE_Create(samples, slots, entries);
+    cache->m_chunkSize = chunkSize;
+    cache->m_slots = slots;
+    cache->m_dimensions = dimensions;
+    cache->m_step = step;
+    cache->m_table.resize(entries * 4);
+    reset_chunk_cache(rimpl.m_kernelAdapter, *cache, getFingerprint());
+
+    rimpl.m_chunks = cache;
+    return true;
+}
+size_t Generator::cacheChunks(const int* chunks, size_t count) {
+    ChunkCacheState* cache = rimpl.m_chunks;
+    if (!cache || !m_noise || lookup_noise(m_noise)) return 0;
+    if (cache->m_fingerprint != getFingerprint()) reset_chunk_cache(rimpl.m_kernelAdapter, *cache, getFingerprint());
+
+    //Touch resident chunks and assign slots to missing ones, at most slots distinct chunks per call
+    std::vector<int> generate;
+    std::unordered_set<unsigned long long> seen;
+    int dims = cache->m_dimensions;
+    for (size_t i = 0; i < count && seen.size() < cache->m_slots; i++) {
+        int x = chunks[i * dims], y = chunks[i * dims + 1], z = dims == 3 ? chunks[i * dims + 2] : 0;
+        unsigned long long key = chunk_key(x, y, z);
+        if (!seen.insert(key).second) continue;
+
+        auto r = cache->m_resident.find(key);
+        if (r != cache->m_resident.end()) {
+            cache->m_lru.splice(cache->m_lru.begin(), cache->m_lru, r->second.lru);
+            continue;
+        }
+
+        int slot;
+        if (cache->m_freeSlots.empty()) {
+            auto evicted = cache->m_resident.find(cache->m_lru.back());
+            slot = evicted->second.slot;
+            cache->m_resident.erase(evicted);
+            cache->m_lru.pop_back();
+        } else {
+            slot = cache->m_freeSlots.back();
+            cache->m_freeSlots.pop_back();
+        }
+
+        cache->m_lru.push_front(key);
+        cache->m_resident[key] = { x, y, z, slot, cache->m_lru.begin() };
+        generate.insert(generate.end(), { x, y, z, slot });
+    }
+
+    if (generate.empty()) return 0;
+    rimpl.m_kernelAdapter->CACHE_Fill(cache->m_store, rimpl.createSnapshot(m_noise), dims, cache->m_chunkSize, cache->m_step, generate.data(), generate.size() / 4);
+    upload_chunk_table(rimpl.m_kernelAdapter, *cache);
+
+    return generate.size() / 4;
+}
+NoiseBuffer Generator::getCachedPoints(const float* points, size_t count, std::vector<int>* misses, size_t maxMisses) {
+    ChunkCacheState* cache = rimpl.m_chunks;
+    if (!cache || !m_noise || lookup_noise(m_noise)) return NoiseBuffer(0, nullptr);
+    if (cache->m_fingerprint != getFingerprint()) reset_chunk_cache(rimpl.m_kernelAdapter, *cache, getFingerprint());
+    if (!prepare(count, false)) return NoiseBuffer(0, nullptr);
+
+    size_t queued = 0;
+    std::vector<int> missed(misses ? 3 * maxMisses : 0);
+    rimpl.m_kernelAdapter->CACHE_Gather(
+        cache->m_store, rimpl.createSnapshot(m_noise),
+        cache->m_dimensions, cache->m_chunkSize, cache->m_step,
+        const_cast<float*>(points), count,
+
+        m_buffer,
+        missed.data(), missed.size() / 3,
+        &queued
+    );
+
+    if (misses) {
+        misses->clear();
+        for (size_t i = 0; i < std::min(queued, maxMisses); i++)
+            misses->insert(misses->end(), missed.begin() + i * 3, missed.begin() + i * 3 + cache->m_dimensions);
+    }
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+void Generator::clearChunkCache() {
+    if (rimpl.m_chunks) reset_chunk_cache(rimpl.m_kernelAdapter, *rimpl.m_chunks, getFingerprint());
+}
+
+// Approximate perturb
+int Generator::getPerturbFactor(float step) const {
+    if (!m_noise || !m_noise->getPerturb()) return 1;
+
+    float frequency = fabs(m_noise->getPerturb()->getFrequency());
+    step = fabs(step);
+    if (frequency <= 0 || step <= 0) return 1;
+
+    float factor = 1.0f / (frequency * step * FN_PERTURB_COARSE_SAMPLES);
+    return (int)std::min(std::max(factor, 1.0f), (float)FN_PERTURB_FACTOR_MAX);
+}
+bool approx_noise(const Noise* noise) {
+    if (!noise) return false;
+    return !(noise->getNoiseType() == NoiseType::Cellular && noise->getCellularReturnType() == CellularReturnType::NoiseLookup);
+}
+bool exact_perturb(const Noise* noise) {
+    return !noise->getPerturb() || noise->getPerturb()->getPerturbType() == PerturbType::None;
+}
+NoiseBuffer Generator::getNoiseApprox(const Range& x, const Range& y, int factor) {
+    if (!approx_noise(m_noise)) return NoiseBuffer(0, nullptr);
+    if (exact_perturb(m_noise)) return getNoise(x, y);
+
+    if (factor <= 0) factor = getPerturbFactor(std::min(fabs(x.step), fabs(y.step)));
+    if (!prepare(x.size * y.size, false)) return NoiseBuffer(0, nullptr);
+
+    rimpl.m_kernelAdapter->GEN_PerturbApprox2(
+        rimpl.createSnapshot(m_noise),
+        factor,
+
+        x.size, y.size,
+        x.step, y.step,
+        x.offset, y.offset,
+
+        m_buffer
+    );
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+NoiseBuffer Generator::getNoiseApprox(const Range& x, const Range& y, const Range& z, int factor) {
+    if (!approx_noise(m_noise)) return NoiseBuffer(0, nullptr);
+    if (exact_perturb(m_noise)) return getNoise(x, y, z);
+
+    if (factor <= 0) factor = getPerturbFactor(std::min(std::min(fabs(x.step), fabs(y.step)), fabs(z.step)));
+    if (!prepare(x.size * y.size * z.size, false)) return NoiseBuffer(0, nullptr);
+
+    rimpl.m_kernelAdapter->GEN_PerturbApprox3(
+        rimpl.createSnapshot(m_noise),
+        factor,
+
+        x.size, y.size, z.size,
+        x.step, y.step, z.step,
+        x.offset, y.offset, z.offset,
+
+        m_buffer
+    );
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+PerturbError compare_perturb(const NoiseBuffer& exact, const NoiseBuffer& approx, int factor) {
+    PerturbError e = { 0, 0, factor };
+    if (!exact.size || exact.size != approx.size) return e;
+
+    double sum = 0;
+    for (size_t i = 0; i < exact.size; i++) {
+        float d = fabs(exact.data[i] - approx.data[i]);
+        e.max = std::max(e.max, d);
+        sum += d;
+    }
+    e.mean = (float)(sum / exact.size);
+
+    return e;
+}
+PerturbError Generator::getPerturbError(const Range& x, const Range& y, int factor) {
+    if (factor <= 0) factor = getPerturbFactor(std::min(fabs(x.step), fabs(y.step)));
+
+    size_t first = m_sliceFirst, count = m_sliceCount;
+    setSlice(0, 0);
+    NoiseBuffer exact = getNoise(x, y);
+    NoiseBuffer approx = getNoiseApprox(x, y, factor);
+    setSlice(first, count);
+
+    return compare_perturb(exact, approx, factor);
+}
+PerturbError Generator::getPerturbError(const Range& x, const Range& y, const Range& z, int factor) {
+    if (factor <= 0) factor = getPerturbFactor(std::min(std::min(fabs(x.step), fabs(y.step)), fabs(z.step)));
+
+    size_t first = m_sliceFirst, count = m_sliceCount;
+    setSlice(0, 0);
+    NoiseBuffer exact = getNoise(x, y, z);
+    NoiseBuffer approx = getNoiseApprox(x, y, z, factor);
+    setSlice(first, count);
+
+    return compare_perturb(exact, approx, factor);
+}
+
+// Points
+NoiseBuffer Generator::getPoints(const float* points, size_t count, int dimensions) {
+    if (!m_noise || !points || (dimensions != 2 && dimensions != 3)) return NoiseBuffer(0, nullptr);
+    if (m_noise->getNoiseType() == NoiseType::Cellular && m_noise->getCellularReturnType() == CellularReturnType::NoiseLookup) return NoiseBuffer(0, nullptr);
+    if (!prepare(count, false)) return NoiseBuffer(0, nullptr);
+
+    if (dimensions == 2) rimpl.m_kernelAdapter->GEN_Points2(rimpl.createSnapshot(m_noise), const_cast<float*>(points), count, m_buffer);
+    else rimpl.m_kernelAdapter->GEN_Points3(rimpl.createSnapshot(m_noise), const_cast<float*>(points), count, m_buffer);
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+
+// Fingerprint
+unsigned long long Generator::getFingerprint() const {
+    return m_noise ? getFingerprint(*m_noise) : 0;
+}
+unsigned long long Generator::getFingerprint(const Noise& noise) const {
+    // FNV-1a over snapshots, which are zero initialized so unused members hash equal
+    unsigned long long hash = 14695981039346656037ULL;
+    const Noise* fnp = &noise;
+
+    while (fnp != nullptr) {
+        Snapshot snap = rimpl.createSnapshot(fnp);
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&snap);
+        for (size_t i = 0; i < sizeof(Snapshot); i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+
+        if (fnp->getNoiseType() != NoiseType::Cellular || fnp->getCellularReturnType() != CellularReturnType::NoiseLookup) break;
+        fnp = fnp->getCellularNoiseLookup();
+    }
+
+    return hash;
+}
+
+// Tiles
+NoiseBuffer Generator::getTiles(const Range* x, const Range* y, size_t count) {
+    if (!m_noise || count == 0) return NoiseBuffer(0, nullptr);
+    if (m_noise->getNoiseType() == NoiseType::Cellular && m_noise->getCellularReturnType() == CellularReturnType::NoiseLookup) return NoiseBuffer(0, nullptr);
+
+    size_t sizeX = x[0].size, sizeY = y[0].size;
+    for (size_t i = 1; i < count; i++)
+        if (x[i].size != sizeX || y[i].size != sizeY) return NoiseBuffer(0, nullptr);
+    if (!prepare(sizeX * sizeY * count, false)) return NoiseBuffer(0, nullptr);
+
+    std::vector<float> tiles(count * 4);
+    for (size_t i = 0; i < count; i++) {
+        tiles[i * 4 + 0] = x[i].offset;
+        tiles[i * 4 + 1] = y[i].offset;
+        tiles[i * 4 + 2] = x[i].step;
+        tiles[i * 4 + 3] = y[i].step;
+    }
+
+    rimpl.m_kernelAdapter->GEN_Tiles2(rimpl.createSnapshot(m_noise), tiles.data(), count, sizeX, sizeY, m_buffer);
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+NoiseBuffer Generator::getBoxes(const SampleBox* boxes, size_t count) {
+    if (!m_noise || count == 0) return NoiseBuffer(0, nullptr);
+    if (m_noise->getNoiseType() == NoiseType::Cellular && m_noise->getCellularReturnType() == CellularReturnType::NoiseLookup) return NoiseBuffer(0, nullptr);
+
+    std::vector<float> origins(count * 4);
+    std::vector<long long> layout(count * 6);
+    size_t size = 0;
+    for (size_t i = 0; i < count; i++) {
+        const SampleBox& b = boxes[i];
+        for (int a = 0; a < 3; a++) {
+            origins[i * 4 + a] = b.origin[a];
+            layout[i * 6 + a] = b.start[a];
+            layout[i * 6 + 3 + a] = b.size[a];
+        }
+        origins[i * 4 + 3] = b.step;
+        size += b.size[0] * b.size[1] * b.size[2];
+    }
+    if (!prepare(size, false)) return NoiseBuffer(0, nullptr);
+
+    rimpl.m_kernelAdapter->GEN_Boxes3(rimpl.createSnapshot(m_noise), origins.data(), layout.data(), count, m_buffer);
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+
+// Biomes
+NoiseBuffer Generator::getNoise(const Range& x, const Range& y, const BiomeMap& map, const std::vector<Noise*>& biomes, float blend) {
+    std::vector<Snapshot> params;
+    if (!map.data || !map.sizeX || !map.sizeY || !rimpl.buildBiomes(biomes, params)) return NoiseBuffer(0, nullptr);
+    if (!prepare(x.size * y.size, false)) return NoiseBuffer(0, nullptr);
+
+    rimpl.m_kernelAdapter->GEN_Biome2(
+        params.data(), params.size(),
+
+        const_cast<unsigned char*>(map.data), map.sizeX, map.sizeY,
+        map.cellSize ? map.cellSize : 1, blend,
+
+        x.size, y.size,
+        x.step, y.step,
+        x.offset, y.offset,
+
+        m_buffer
+    );
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+NoiseBuffer Generator::getNoise(const Range& x, const Range& y, const Range& z, const BiomeMap& map, const std::vector<Noise*>& biomes, float blend) {
+    std::vector<Snapshot> params;
+    if (!map.data || !map.sizeX || !map.sizeY || !rimpl.buildBiomes(biomes, params)) return NoiseBuffer(0, nullptr);
+    if (!prepare(x.size * y.size * z.size, false)) return NoiseBuffer(0, nullptr);
+
+    rimpl.m_kernelAdapter->GEN_Biome3(
+        params.data(), params.size(),
+
+        const_cast<unsigned char*>(map.data), map.sizeX, map.sizeY,
+        map.cellSize ? map.cellSize : 1, blend,
+
+        x.size, y.size, z.size,
+        x.step, y.step, z.step,
+        x.offset, y.offset, z.offset,
+
+        m_buffer
+    );
+
+    return NoiseBuffer(m_bufSize, m_buffer);
+}
+
+// Async
+struct AsyncRequest {
+    NoiseCallback done;
+    void* data;
+    float* buffer;
+    size_t size;
+};
+void async_done(void* data, bool success) {
+    AsyncRequest* request = (AsyncRequest*)data;
+    if (!success) {
+        delete[] request->buffer;
+        request->done(request->data, NoiseBuffer(0, nullptr));
+    } else request->done(request->data, NoiseBuffer(request->size, request->buffer));
+    delete request;
+}
+
+bool Generator::getNoiseAsync(const Range& x, NoiseCallback done, void* data) {
+    const Range* ranges[] = { &x };
+    return startAsync(ranges, 1, done, data);
+}
+bool Generator::getNoiseAsync(const Range& x, const Range& y, NoiseCallback done, void* data) {
+    const Range* ranges[] = { &x, &y };
+    return startAsync(ranges, 2, done, data);
+}
+bool Generator::getNoiseAsync(const Range& x, const Range& y, const Range& z, NoiseCallback done, void* data) {
+    const Range* ranges[] = { &x, &y, &z };
+    return startAsync(ranges, 3, done, data);
+}
+bool Generator::getNoiseAsync(const Range& x, const Range& y, const Range& z, const Range& w, NoiseCallback done, void* data) {
+    const Range* ranges[] = { &x, &y, &z, &w };
+    return startAsync(ranges, 4, done, data);
+}
+bool Generator::startAsync(const Range* const* ranges, int dimensions, NoiseCallback done, void* data) {
+    if (!m_noise || !done) return false;
+
+    size_t sizes[4], size = 1;
+    float scales[4], offsets[4];
+    for (int d = 0; d < dimensions; d++) {
+        sizes[d] = ranges[d]->size;
+        scales[d] = ranges[d]->step;
+        offsets[d] = ranges[d]->offset;
+        size *= sizes[d];
+    }
+    if (!prepare(size)) return false;
+
+    bool lookup = lookup_noise(m_noise);
+    std::vector<Snapshot> chain = lookup ? rimpl.buildSnapshotChain() : std::vector<Snapshot>(1, rimpl.createSnapshot(m_noise));
+
+    AsyncRequest* request = new AsyncRequest{ done, data, m_buffer, m_bufSize };
+    if (!rimpl.m_kernelAdapter->GEN_Async(chain.data(), chain.size(), lookup, dimensions, sizes, scales, offsets, m_buffer, async_done, request)) {
+        delete[] m_buffer;
+        m_buffer = nullptr;
+        delete request;
+        return false;
+    }
+
+    return true;
+}
+
+// Slices
+void Generator::setSlice(size_t first, size_t count) {
+    m_sliceFirst = first;
+    m_sliceCount = count;
+}
+size_t Generator::getSliceFirst() const {
+    return m_sliceFirst;
+}
+size_t Generator::getSliceCount() const {
+    return m_sliceCount;
+}
+
 // Getters/Setters
 void Generator::setNoise(Noise* noise) {
     m_noise = noise;
@@ -314,6 +1197,12 @@ void Generator::setNoise(Noise* noise) {
 Noise* Generator::getNoise() const {
     return m_noise;
 }
+void Generator::setExecutor(Executor* executor) {
+    m_executor = executor;
+}
+Executor& Generator::getExecutor() const {
+    return m_executor ? *m_executor : Executor::getDefault();
+}
 
 // Misc
 void Generator::prepareDevice(const Device& device) {
@@ -325,6 +1214,13 @@ void Generator::prepareBuffer(size_t size) {
     m_buffer = new float[m_bufSize];
 }
 
+BiomeMap::BiomeMap(const unsigned char* data, size_t sizeX, size_t sizeY, size_t cellSize) {
+    this->data = data;
+    this->sizeX = sizeX;
+    this->sizeY = sizeY;
+    this->cellSize = cellSize;
+}
+
 template<typename T>
 RangeContainer<T>::RangeContainer(std::size_t size, T offset, T step) {
     this->size = size;
@@ -341,3 +1237,38 @@ RangeContainer<T>& RangeContainer<T>::operator= (RangeContainer& r) {
 }
 template class RangeContainer<float>;
 template class RangeContainer<int>;
+
+// Mesh
+bool Generator::displaceMesh(const float* positions, const float* normals, size_t vertexCount,
+                             const unsigned int* indices, size_t indexCount, float scale,
+                             float* resultPositions, float* resultNormals) {
+    if (!m_noise || !rimpl.m_kernelAdapter) return false;
+    if (!positions || !normals || !resultPositions || !resultNormals || vertexCount == 0) return false;
+    if (!indices || indexCount == 0 || indexCount % 3 != 0) return false;
+
+    // Triangles of every vertex, built once on host since only topology is needed
+    size_t faceCount = indexCount / 3;
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < indexCount; i++) {
+        if (indices[i] >= vertexCount) return false;
+        offsets[indices[i] + 1]++;
+    }
+    for (size_t v = 1; v <= vertexCount; v++) offsets[v] += offsets[v - 1];
+
+    std::vector<unsigned int> faces(indexCount);
+    std::vector<unsigned int> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indexCount; i++) faces[next[indices[i]]++] = (unsigned int)(i / 3);
+
+    rimpl.m_kernelAdapter->GEN_Mesh3(
+        rimpl.createSnapshot(m_noise),
+        scale,
+
+        const_cast<float*>(positions), const_cast<float*>(normals), vertexCount,
+        const_cast<unsigned int*>(indices), faceCount,
+        offsets.data(), faces.data(),
+
+        resultPositions, resultNormals
+    );
+
+    return true;
+}
@@ -29,8 +29,11 @@
 #define Generator_H
 
 #include <cstdlib>
+#include <cfloat>
+#include <vector>
 #include "DeviceManager.h"
 #include "Noise.h"
+#include "Executor.h"
 
 template<typename T>
 class RangeContainer {
@@ -40,11 +43,64 @@ public:
     T step;
 
     RangeContainer(std::size_t size, T offset, T step);
+    RangeContainer(const RangeContainer& r) = default;
     RangeContainer& operator= (RangeContainer& r);
 };
 //! \brief contains information about range of coordinate floating-point values to be used in generation
 typedef RangeContainer<float> Range;
 
+//! \brief difference of approximate perturb result to exact one
+struct PerturbError {
+    float max;
+    float mean;
+    //! \brief factor the approximation used
+    int factor;
+};
+
+/*! \brief 3D grid stored as bricks of size^3 samples, bricks within epsilon of one value keep only that value
+ * Bricks and samples inside a brick are ordered like Generator output, bricks past the edge repeat the last sample
+ */
+struct Brickmap {
+    static const size_t size = 8;
+
+    std::size_t bricksX;
+    std::size_t bricksY;
+    std::size_t bricksZ;
+
+    //! \brief pool entry of every brick, -1 for uniform bricks
+    std::vector<int> table;
+    //! \brief value of every brick, only used for uniform ones
+    std::vector<float> values;
+    //! \brief size^3 samples of every non-uniform brick
+    std::vector<float> pool;
+
+    //! \brief Returns sample at given index of the generated grid
+    float getSample(std::size_t x, std::size_t y, std::size_t z) const;
+};
+
+/*! \brief 3D box of samples for Generator::getBoxes
+ * Sample (i, j, k) is at origin + (start + index) * step on each axis, so a sample gets the
+ * same coordinates in every box that contains it
+ */
+struct SampleBox {
+    float origin[3];
+    long long start[3];
+    std::size_t size[3];
+    float step;
+};
+
+//! \brief 2D map of biome indices, each cell covers cellSize samples along x and y
+class BiomeMap {
+public:
+    //! \brief sizeX * sizeY indices, stored with y changing fastest
+    const unsigned char* data;
+    size_t sizeX;
+    size_t sizeY;
+    size_t cellSize;
+
+    BiomeMap(const unsigned char* data, size_t sizeX, size_t sizeY, size_t cellSize = 1);
+};
+
 //! \brief stores results of noise get functions
 class NoiseBuffer {
 public:
@@ -52,9 +108,14 @@ public:
     float* data = nullptr;
 
     NoiseBuffer(size_t size, float* data);
+    NoiseBuffer(NoiseBuffer&& other);
+    NoiseBuffer& operator= (NoiseBuffer&& other);
     ~NoiseBuffer();
 };
 
+//! \brief receives result of asynchronous generation, empty if it failed
+typedef void (*NoiseCallback)(void* data, NoiseBuffer&& result);
+
 class Generator {
 public:
     //! \brief Create generator
@@ -64,8 +125,18 @@ public:
     //! \brief Sets Noise object for generator to use
     void setNoise(Noise* noise);
     Noise* getNoise() const;
+    /*! \brief Sets Executor host work of generator and helpers using it (Pipeline, etc.) is submitted to
+     * nullptr uses Executor::getDefault()
+     */
+    void setExecutor(Executor* executor);
+    Executor& getExecutor() const;
 
     // Generation
+    // Results are stored with y changing fastest, then x, then z and w
+    //1D
+    //! \brief Only works with Value, Perlin and Simplex noise types and their fractals, perturb is ignored
+    NoiseBuffer getNoise(const Range& x);
+
     //2D
     NoiseBuffer getNoise(const Range& x, const Range& y);
 
@@ -76,14 +147,192 @@ public:
     //! \brief Only works with noise types of Simplex of WhiteNoise
     NoiseBuffer getNoise(const Range& x, const Range& y, const Range& z, const Range& w);
 
+    //Async
+    /*! \brief Same as getNoise, but returns as soon as the work is queued
+     * done is called from an OpenCL runtime thread once the result is read back. Noise settings and
+     * slice are captured by the call. Returns false without calling done if nothing was started.
+     * See CompletionQueue for use in event loops
+     */
+    bool getNoiseAsync(const Range& x, NoiseCallback done, void* data);
+    bool getNoiseAsync(const Range& x, const Range& y, NoiseCallback done, void* data);
+    bool getNoiseAsync(const Range& x, const Range& y, const Range& z, NoiseCallback done, void* data);
+    bool getNoiseAsync(const Range& x, const Range& y, const Range& z, const Range& w, NoiseCallback done, void* data);
+
+    //Selection
+    /*! \brief Returns the sample values that each fraction of the generated samples is below, e.g. 0.5 gives the median
+     * Samples stay on device and values are selected exactly with a radix select over their bits.
+     * Cellular NoiseLookup is not supported
+     */
+    std::vector<float> getPercentiles(const Range& x, const Range& y, const std::vector<float>& fractions);
+    std::vector<float> getPercentiles(const Range& x, const Range& y, const Range& z, const std::vector<float>& fractions);
+    /*! \brief Returns 1 for samples at or above the value fraction of samples is below, 0 for others
+     * e.g. fraction 0.65 marks 35% of samples. threshold receives the value if not nullptr
+     */
+    std::vector<unsigned char> getMask(const Range& x, const Range& y, float fraction, float* threshold = nullptr);
+    std::vector<unsigned char> getMask(const Range& x, const Range& y, const Range& z, float fraction, float* threshold = nullptr);
+
+    //Block compression
+    /*! \brief Generates x by y samples and returns them as BC4 blocks encoded on device
+     * [low, high] is mapped to 0 - 255. Texture rows run along x, columns along y, blocks are stored
+     * like samples of getNoise with 8 bytes each. Partial edge blocks repeat the last sample.
+     * quality is the number of endpoint pairs tried per block, 1 uses min and max only.
+     * Cellular NoiseLookup is not supported
+     */
+    std::vector<unsigned char> getBC4(const Range& x, const Range& y, float low, float high, int quality = 1);
+    //! \brief Same as getBC4 with Noise of generator as first and green as second channel, 16 bytes per block
+    std::vector<unsigned char> getBC5(const Range& x, const Range& y, const Noise& green, float low, float high, int quality = 1);
+
+    //Axis grids
+    /*! \brief Generates a grid with coordinates of every axis given as array, e.g. for stretched spacing
+     * Stored like getNoise, only the arrays are uploaded. Cellular NoiseLookup is not supported
+     */
+    NoiseBuffer getGrid(const std::vector<float>& x, const std::vector<float>& y);
+    NoiseBuffer getGrid(const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z);
+
+    //Levels
+    /*! \brief Generates levels + 1 grids of the same region, each with twice the resolution of the previous one
+     * Level 0 uses the given ranges, level l has (size - 1) * 2^l + 1 samples with step / 2^l along each axis.
+     * Samples shared with the previous level are copied, only new ones are evaluated.
+     * Every level is stored like getNoise and stays on device as input of the next one.
+     * Returns no levels if any of them can not be generated. Cellular NoiseLookup is not supported
+     */
+    std::vector<NoiseBuffer> getLevels(const Range& x, const Range& y, size_t levels);
+    std::vector<NoiseBuffer> getLevels(const Range& x, const Range& y, const Range& z, size_t levels);
+
+    //Worms
+    /*! \brief Generates a 3D grid like getNoise and carves the tunnels of Perlin worms into it
+     * starts holds x, y, z and radius of every worm in noise coordinates. Each worm walks steps
+     * steps of length step, turning by turn * PI radians per unit of steering noise.
+     * Samples within radius of a path are lowered by depth * (1 - distance^2 / radius^2).
+     * Everything stays on device until the carved grid is read back. Cellular NoiseLookup is not supported
+     */
+    NoiseBuffer carveWorms(const Range& x, const Range& y, const Range& z, const Noise& steering, const std::vector<float>& starts, size_t steps, float step, float turn = 0.25f, float depth = 2.0f);
+
+    //Brickmap
+    /*! \brief Generates a 3D grid like getNoise and stores it as Brickmap
+     * Samples are clamped to [low, high] first, so bricks of solid or open space become uniform.
+     * Bricks are generated and classified on device without storing the dense grid, non-uniform ones
+     * are generated a second time into the pool. Only the brick table and the pool are read back.
+     * Cellular NoiseLookup is not supported
+     */
+    Brickmap getBrickmap(const Range& x, const Range& y, const Range& z, float epsilon, float low = -FLT_MAX, float high = FLT_MAX);
+
+    //Chunk cache
+    /*! \brief Keeps up to slots chunks of the current Noise resident on device for getCachedPoints
+     * A chunk holds chunkSize samples along each of dimensions axes with distance step, chunk c starts at
+     * sample c * (chunkSize - 1) so neighbours share edge samples. Replaces a previous cache, 0 slots releases it.
+     * Only works with 2 or 3 dimensions
+     */
+    bool setChunkCache(size_t chunkSize, size_t slots, int dimensions, float step = 1.0f);
+    /*! \brief Makes chunks resident, dimensions ints per chunk
+     * Resident chunks are only marked as used, missing ones replace least recently used ones and are
+     * generated in one dispatch. At most slots distinct chunks are handled per call.
+     * Cache is dropped when Noise settings change. Cellular NoiseLookup is not supported
+     * \return number of chunks generated
+     */
+    size_t cacheChunks(const int* chunks, size_t count);
+    /*! \brief Same as getPoints with dimensions of the chunk cache, interpolating resident chunks
+     * Points in missing chunks are evaluated directly. If misses is not nullptr it receives up to maxMisses
+     * missed chunks, each once, ready to be passed to cacheChunks
+     */
+    NoiseBuffer getCachedPoints(const float* points, size_t count, std::vector<int>* misses = nullptr, size_t maxMisses = 1024);
+    //! \brief Drops all resident chunks
+    void clearChunkCache();
+
+    //Approximate perturb
+    /*! \brief Same as getNoise, but perturb is computed on a grid factor times coarser and interpolated per sample
+     * factor 0 chooses it from perturb frequency and step, see getPerturbFactor.
+     * Without perturb this is getNoise. Cellular NoiseLookup is not supported
+     */
+    NoiseBuffer getNoiseApprox(const Range& x, const Range& y, int factor = 0);
+    NoiseBuffer getNoiseApprox(const Range& x, const Range& y, const Range& z, int factor = 0);
+    /*! \brief Returns factor used for given sample step when factor 0 is requested
+     * About 16 coarse samples per perturb wavelength, between 1 and 16
+     */
+    int getPerturbFactor(float step) const;
+    //! \brief Generates both paths and compares them
+    PerturbError getPerturbError(const Range& x, const Range& y, int factor = 0);
+    PerturbError getPerturbError(const Range& x, const Range& y, const Range& z, int factor = 0);
+
+    //Points
+    /*! \brief Evaluates Noise at count arbitrary points, dimensions floats per point
+     * Only works with 2 or 3 dimensions, Cellular NoiseLookup is not supported
+     */
+    NoiseBuffer getPoints(const float* points, size_t count, int dimensions);
+
+    //Fingerprint
+    /*! \brief Returns hash of every setting of Noise and its NoiseLookup chain
+     * Equal configurations give equal fingerprints, 0 if no Noise is set
+     */
+    unsigned long long getFingerprint() const;
+    //! \brief Same for any Noise, without setting it
+    unsigned long long getFingerprint(const Noise& noise) const;
+
+    //Slices
+    /*! \brief Restricts following 1D-4D getNoise calls to samples [first, first + count) of the request
+     * Returned buffer holds only these samples, count 0 disables slicing.
+     * Tiles, boxes and biomes are never sliced
+     */
+    void setSlice(size_t first, size_t count);
+    size_t getSliceFirst() const;
+    size_t getSliceCount() const;
+
+    //Octaves
+    /*! \brief Adds octaves [first, last) of the fractal Noise to result
+     * result holds x.size * y.size (* z.size) values, e.g. octaves stored by a previous call or zeros.
+     * Octaves are scaled by the bounding of the Noise Fractal, so summing ranges covering all its
+     * octaves gives the getNoise result up to float rounding.
+     * Only works with ValueFractal, PerlinFractal and SimplexFractal
+     */
+    bool addOctaves(const Range& x, const Range& y, int first, int last, float* result);
+    bool addOctaves(const Range& x, const Range& y, const Range& z, int first, int last, float* result);
+
+    //Tiles
+    /*! \brief Generates several 2D tiles of equal size in one dispatch
+     * Tiles are stored one after another, each in the same layout as getNoise(x, y)
+     * Cellular NoiseLookup is not supported
+     */
+    NoiseBuffer getTiles(const Range* x, const Range* y, size_t count);
+
+    /*! \brief Generates several 3D boxes of any size in one dispatch
+     * Boxes are stored one after another, each in the same layout as getNoise(x, y, z)
+     * Cellular NoiseLookup is not supported
+     */
+    NoiseBuffer getBoxes(const SampleBox* boxes, size_t count);
+
+    //Biomes
+    /*! \brief Every sample evaluates only the Noise of its biome
+     * Biomes closer than blend samples are blended in, 0 disables blending.
+     * Samples are processed grouped by biome. 3D uses the map for every z slice
+     * Cellular NoiseLookup is not supported
+     */
+    NoiseBuffer getNoise(const Range& x, const Range& y, const BiomeMap& map, const std::vector<Noise*>& biomes, float blend = 0);
+    NoiseBuffer getNoise(const Range& x, const Range& y, const Range& z, const BiomeMap& map, const std::vector<Noise*>& biomes, float blend = 0);
+
+    //Mesh
+    /*! \brief Displaces vertices along their normals by scale * noise and recomputes smooth normals on device
+     * positions and normals hold 3 floats per vertex, indices 3 vertices per triangle.
+     * Needs at least one triangle. Results may be written over the inputs, vertices without triangles keep their normal.
+     * Cellular NoiseLookup is not supported
+     */
+    bool displaceMesh(const float* positions, const float* normals, size_t vertexCount,
+                      const unsigned int* indices, size_t indexCount, float scale,
+                      float* resultPositions, float* resultNormals);
+
 protected:
     float* m_buffer;
     size_t m_bufSize;
 
     Noise* m_noise;
 
+    size_t m_sliceFirst;
+    size_t m_sliceCount;
+
+    Executor* m_executor;
+
 private:
-    bool prepare(const size_t size);
+    bool prepare(const size_t size, bool sliced = true);
+    bool startAsync(const Range* const* ranges, int dimensions, NoiseCallback done, void* data);
     void prepareBuffer(size_t size);
     void prepareDevice(const Device& device);
 
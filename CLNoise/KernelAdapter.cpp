@@ -30,7 +30,10 @@
 #include <CL/cl.hpp>
 #include <vector>
 #include <assert.h>
+#include <string.h>
+#include <algorithm>
 #include <map>
+#include <mutex>
 
 #include <string>
 
@@ -181,7 +184,7 @@ const char *getErrorString(cl_int error) {
 const string src =
 #include "Noise.cl"
     ;
-#define KERNEL_COUNT 20
+#define KERNEL_COUNT 63
 const char* kernel_names[KERNEL_COUNT] = {
     "GEN_Value2",
     "GEN_ValueFractal2",
@@ -202,7 +205,50 @@ const char* kernel_names[KERNEL_COUNT] = {
     "GEN_Simplex4",
     "GEN_WhiteNoise4",
     "GEN_Lookup_Cellular2",
-    "GEN_Lookup_Cellular3"
+    "GEN_Lookup_Cellular3",
+    "GEN_Tiles2",
+    "GEN_Biome2",
+    "GEN_Biome3",
+    "GEN_Value1",
+    "GEN_ValueFractal1",
+    "GEN_Perlin1",
+    "GEN_PerlinFractal1",
+    "GEN_Simplex1",
+    "GEN_SimplexFractal1",
+    "GEN_Octaves2",
+    "GEN_Octaves3",
+    "GEN_Displace3",
+    "GEN_FaceNormals3",
+    "GEN_VertexNormals3",
+    "GEN_Points2",
+    "GEN_Points3",
+    "GEN_PerturbField2",
+    "GEN_PerturbField3",
+    "GEN_PerturbApprox2",
+    "GEN_PerturbApprox3",
+    "GEN_Inject2",
+    "GEN_Inject3",
+    "GEN_Refine2",
+    "GEN_Refine3",
+    "GEN_Grid2",
+    "GEN_Grid3",
+    "GEN_BC4",
+    "GEN_BC5",
+    "SEL_Histogram",
+    "SEL_Mask",
+    "GEN_Worms3",
+    "GEN_Carve3",
+    "GEN_CarveApply3",
+    "CACHE_Fill2",
+    "CACHE_Fill3",
+    "CACHE_Gather2",
+    "CACHE_Gather3",
+    "BRICK_Classify",
+    "BRICK_Fill",
+    "BIOME_Count",
+    "BIOME_Scan",
+    "BIOME_Scatter",
+    "GEN_Boxes3"
 };
 enum Kernel {
     VALUE2 = 0,
@@ -225,6 +271,147 @@ enum Kernel {
     WHITENOISE4 = 17,
     LOOKUP_CELLULAR2 = 18,
     LOOKUP_CELLULAR3 = 19,
+    TILES2 = 20,
+    BIOME2 = 21,
+    BIOME3 = 22,
+    VALUE1 = 23,
+    VALUEFRACTAL1 = 24,
+    PERLIN1 = 25,
+    PERLINFRACTAL1 = 26,
+    SIMPLEX1 = 27,
+    SIMPLEXFRACTAL1 = 28,
+    OCTAVES2 = 29,
+    OCTAVES3 = 30,
+    DISPLACE3 = 31,
+    FACENORMALS3 = 32,
+    VERTEXNORMALS3 = 33,
+    POINTS2 = 34,
+    POINTS3 = 35,
+    PERTURBFIELD2 = 36,
+    PERTURBFIELD3 = 37,
+    PERTURBAPPROX2 = 38,
+    PERTURBAPPROX3 = 39,
+    INJECT2 = 40,
+    INJECT3 = 41,
+    REFINE2 = 42,
+    REFINE3 = 43,
+    GRID2 = 44,
+    GRID3 = 45,
+    BC4 = 46,
+    BC5 = 47,
+    SEL_HISTOGRAM = 48,
+    SEL_MASK = 49,
+    WORMS3 = 50,
+    CARVE3 = 51,
+    CARVEAPPLY3 = 52,
+    CACHE_FILL2 = 53,
+    CACHE_FILL3 = 54,
+    CACHE_GATHER2 = 55,
+    CACHE_GATHER3 = 56,
+    BRICK_CLASSIFY = 57,
+    BRICK_FILL = 58,
+    BIOME_COUNT = 59,
+    BIOME_SCAN = 60,
+    BIOME_SCATTER = 61,
+    BOXES3 = 62,
+};
+
+//Launch parameters
+struct LaunchParams {
+    cl_ulong m_size[4];  // |
+    float m_scale[4];    // | Ranges, unused axes are left zero
+    float m_offset[4];   // |
+
+    cl_uint m_count;     // Snapshots following the header
+    cl_uint m_padding;   // Keeps the chain 8 byte aligned on every host, like on device
+};
+
+void CL_CALLBACK release_staging(cl_event, cl_int, void* data) {
+    delete (std::vector<unsigned char>*)data;
+}
+
+/*
+ * Persistent __constant blocks shared by every launch on a device
+ *   Each block holds LaunchParams followed by a chain of Snapshots. A ring of blocks keeps
+ *   the last few packed parameter sets, a launch matching one of them costs no upload.
+ *   Otherwise the oldest block is rewritten with a non-blocking write, the queue is in-order
+ *   so the write runs after earlier kernels reading that block, and the host never waits.
+ *   Lock m_mutex from update until the kernel is enqueued with m_waits as its wait list.
+ *   The mutex only orders launches using the block, helper kernels with plain arguments
+ *   share cl::Kernel objects per device and must not be called concurrently on one device.
+ */
+class LaunchBlock {
+public:
+    static const size_t ring_size = 4;
+
+    std::mutex m_mutex;
+    cl::Buffer m_buffer;            // Block to pass to the kernel
+    std::vector<cl::Event> m_waits; // Upload of the block the kernel has to wait for
+
+    void update(
+        cl::Context& context, cl::CommandQueue& cmdQueue,
+        LaunchParams header, const Snapshot* chain, size_t count
+    ) {
+        //Pack block
+        header.m_count = (cl_uint)count;
+        header.m_padding = 0;
+        std::vector<unsigned char> block(sizeof(LaunchParams) + sizeof(Snapshot) * count);
+        memcpy(block.data(), &header, sizeof(LaunchParams));
+        memcpy(block.data() + sizeof(LaunchParams), chain, sizeof(Snapshot) * count);
+
+        //Reuse a block holding the same bytes
+        m_waits.clear();
+        for (Slot& slot : m_slots) {
+            if (slot.m_host != block) continue;
+            m_buffer = slot.m_buffer;
+            m_waits.push_back(slot.m_upload);
+            return;
+        }
+
+        //Rewrite oldest block, grow buffer if needed
+        Slot& slot = m_slots[m_next];
+        m_next = (m_next + 1) % ring_size;
+
+        cl_int err;
+        if (block.size() > slot.m_capacity) {
+            slot.m_capacity = block.size();
+            slot.m_buffer = cl::Buffer(context, CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, slot.m_capacity, nullptr, &err);
+            assert(err == CL_SUCCESS);
+        }
+        slot.m_host = block;
+
+        //Write from a staging copy freed once the upload finished
+        std::vector<unsigned char>* staging = new std::vector<unsigned char>(std::move(block));
+        err = cmdQueue.enqueueWriteBuffer(slot.m_buffer, CL_FALSE, 0, staging->size(), staging->data(), nullptr, &slot.m_upload);
+        assert(err == CL_SUCCESS);
+        err = clSetEventCallback(slot.m_upload(), CL_COMPLETE, release_staging, staging);
+        if (err != CL_SUCCESS) {
+            // Nothing frees staging then, wait until the write has read it
+            slot.m_upload.wait();
+            delete staging;
+        }
+
+        m_buffer = slot.m_buffer;
+        m_waits.push_back(slot.m_upload);
+    }
+private:
+    struct Slot {
+        cl::Buffer m_buffer;
+        cl::Event m_upload;
+        std::vector<unsigned char> m_host;
+        size_t m_capacity = 0;
+    };
+    Slot m_slots[ring_size];
+    size_t m_next = 0;
+};
+
+//Chunk cache
+class ChunkStore {
+public:
+    cl::Buffer m_pool;      // chunkSamples floats per slot
+    cl::Buffer m_table;     // 4 ints per entry
+    size_t m_chunkSamples;
+    size_t m_tableEntries;
 };
 
 //Initialize
@@ -233,10 +420,12 @@ public:
     cl::Context m_context;
     cl::Kernel* m_kernels = nullptr;
     cl::CommandQueue m_cmdQueue;
+    LaunchBlock* m_launch = nullptr;
 
     impl() {}
     ~impl() {
         if (m_kernels != nullptr) delete[] m_kernels;
+        if (m_launch != nullptr) delete m_launch;
     }
 };
 
@@ -256,6 +445,9 @@ private:
 KernelAdapter::simpl& KernelAdapter::rsimpl = *(new simpl);
 
 KernelAdapter::KernelAdapter(const Device& dev) : rimpl(rsimpl.getImpl(dev.getDevicePtr())) {
+    m_sliceFirst = 0;
+    m_sliceCount = 0;
+
     if (rimpl.m_kernels) return;
 
     cl::Device& device = *(cl::Device*)dev.getDevicePtr();
@@ -269,6 +461,7 @@ KernelAdapter::KernelAdapter(const Device& dev) : rimpl(rsimpl.getImpl(dev.getDe
     auto err = program.build("-cl-std=CL1.2");
     assert(err == CL_SUCCESS);
 
+    rimpl.m_launch = new LaunchBlock;
     rimpl.m_kernels = new cl::Kernel[KERNEL_COUNT];
     for (size_t i = 0; i < KERNEL_COUNT; i++) {
         rimpl.m_kernels[i] = cl::Kernel(program, kernel_names[i], &err);
@@ -277,43 +470,96 @@ KernelAdapter::KernelAdapter(const Device& dev) : rimpl(rsimpl.getImpl(dev.getDe
 }
 KernelAdapter::~KernelAdapter() {}
 
+//Slices
+void KernelAdapter::setSlice(size_t first, size_t count) {
+    m_sliceFirst = first;
+    m_sliceCount = count;
+}
+
 //Kernels
 
+template <typename T>
+void exec_kernel_1D(
+    cl::Kernel& kernel,           // |
+    cl::Context& context,         // | IN : KernelAdapter::impl
+    cl::CommandQueue& cmdQueue,   // |
+
+    LaunchBlock& launch,          // IN : persistent launch parameters
+    Snapshot param,               // IN : class members
+
+    size_t sizeX,                 // |
+    T scaleX,                     // | IN : Parameters
+    T offsetX,                    // |
+
+    float* result,
+    size_t first, size_t count    // IN : slice of samples, count 0 for all
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = count ? count : sizeX - first;
+
+    //Create buffers
+    cl::Buffer buf_result(context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    LaunchParams header = {};
+    header.m_size[0] = sizeX;
+    header.m_scale[0] = scaleX;
+    header.m_offset[0] = offsetX;
+    std::unique_lock<std::mutex> lock(launch.m_mutex);
+    launch.update(context, cmdQueue, header, &param, 1);
+    kernel.setArg(0, launch.m_buffer);
+    kernel.setArg(1, buf_result);
+
+    //Execute task
+    err = cmdQueue.enqueueNDRangeKernel(kernel, cl::NDRange(first), cl::NDRange(msize), cl::NullRange, &launch.m_waits);
+    assert(err == CL_SUCCESS);
+    lock.unlock();
+    err = cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
 template <typename T>
 void exec_kernel_2D(
     cl::Kernel& kernel,           // |
     cl::Context& context,         // | IN : KernelAdapter::impl
     cl::CommandQueue& cmdQueue,   // |
 
+    LaunchBlock& launch,          // IN : persistent launch parameters
     Snapshot param,                // IN : class members
 
     size_t sizeX, size_t sizeY,   // |
     T scaleX, T scaleY,           // | IN : Parameters
     T offsetX, T offsetY,         // |
 
-    float* result
+    float* result,
+    size_t first, size_t count    // IN : slice of samples, count 0 for all
 ) {
     //Configure stuff
     cl_int err;
-    size_t msize = sizeX * sizeY;
+    size_t msize = count ? count : sizeX * sizeY - first;
 
     //Create buffers
     cl::Buffer buf_result(context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
     assert(err == CL_SUCCESS);
 
     //Prepare kernel
-    kernel.setArg(0, sizeof(Snapshot), &param);
-    kernel.setArg(1, sizeof(size_t), &sizeX);
-    kernel.setArg(2, sizeof(size_t), &sizeY);
-    kernel.setArg(3, sizeof(T), &scaleX);
-    kernel.setArg(4, sizeof(T), &scaleY);
-    kernel.setArg(5, sizeof(T), &offsetX);
-    kernel.setArg(6, sizeof(T), &offsetY);
-    kernel.setArg(7, buf_result);
+    LaunchParams header = {};
+    header.m_size[0] = sizeX;
+    header.m_size[1] = sizeY;
+    header.m_scale[0] = scaleX;
+    header.m_scale[1] = scaleY;
+    header.m_offset[0] = offsetX;
+    header.m_offset[1] = offsetY;
+    std::unique_lock<std::mutex> lock(launch.m_mutex);
+    launch.update(context, cmdQueue, header, &param, 1);
+    kernel.setArg(0, launch.m_buffer);
+    kernel.setArg(1, buf_result);
 
     //Execute task
-    err = cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    err = cmdQueue.enqueueNDRangeKernel(kernel, cl::NDRange(first), cl::NDRange(msize), cl::NullRange, &launch.m_waits);
     assert(err == CL_SUCCESS);
+    lock.unlock();
     err = cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
     assert(err == CL_SUCCESS);
 }
@@ -323,38 +569,44 @@ void exec_kernel_3D(
     cl::Context& context,                        // | IN : KernelAdapter::impl
     cl::CommandQueue& cmdQueue,                  // |
 
+    LaunchBlock& launch,                         // IN : persistent launch parameters
     Snapshot param,                              // IN : class members
 
     size_t sizeX, size_t sizeY, size_t sizeZ,    // |
     T scaleX, T scaleY, T scaleZ,                // | IN : Parameters
     T offsetX, T offsetY, T offsetZ,             // |
 
-    float* result
+    float* result,
+    size_t first, size_t count    // IN : slice of samples, count 0 for all
 ) {
     //Configure stuff
     cl_int err;
-    size_t msize = sizeX * sizeY * sizeZ;
+    size_t msize = count ? count : sizeX * sizeY * sizeZ - first;
 
     //Create buffers
     cl::Buffer buf_result(context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
     assert(err == CL_SUCCESS);
 
     //Prepare kernel
-    kernel.setArg(0, sizeof(Snapshot), &param);
-    kernel.setArg(1, sizeof(size_t), &sizeX);
-    kernel.setArg(2, sizeof(size_t), &sizeY);
-    kernel.setArg(3, sizeof(size_t), &sizeZ);
-    kernel.setArg(4, sizeof(T), &scaleX);
-    kernel.setArg(5, sizeof(T), &scaleY);
-    kernel.setArg(6, sizeof(T), &scaleZ);
-    kernel.setArg(7, sizeof(T), &offsetX);
-    kernel.setArg(8, sizeof(T), &offsetY);
-    kernel.setArg(9, sizeof(T), &offsetZ);
-    kernel.setArg(10, buf_result);
+    LaunchParams header = {};
+    header.m_size[0] = sizeX;
+    header.m_size[1] = sizeY;
+    header.m_size[2] = sizeZ;
+    header.m_scale[0] = scaleX;
+    header.m_scale[1] = scaleY;
+    header.m_scale[2] = scaleZ;
+    header.m_offset[0] = offsetX;
+    header.m_offset[1] = offsetY;
+    header.m_offset[2] = offsetZ;
+    std::unique_lock<std::mutex> lock(launch.m_mutex);
+    launch.update(context, cmdQueue, header, &param, 1);
+    kernel.setArg(0, launch.m_buffer);
+    kernel.setArg(1, buf_result);
 
     //Execute task
-    err = cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    err = cmdQueue.enqueueNDRangeKernel(kernel, cl::NDRange(first), cl::NDRange(msize), cl::NullRange, &launch.m_waits);
     assert(err == CL_SUCCESS);
+    lock.unlock();
     err = cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
     assert(err == CL_SUCCESS);
 }
@@ -364,45 +616,125 @@ void exec_kernel_4D(
     cl::Context& context,                                       // | IN : KernelAdapter::impl
     cl::CommandQueue& cmdQueue,                                 // |
 
+    LaunchBlock& launch,                                        // IN : persistent launch parameters
     Snapshot param,                                             // IN : class members
 
     size_t sizeX, size_t sizeY, size_t sizeZ, size_t sizeW,     // |
     T scaleX, T scaleY, T scaleZ, T scaleW,                     // | IN : Parameters
     T offsetX, T offsetY, T offsetZ, T offsetW,                 // |
 
-    float* result
+    float* result,
+    size_t first, size_t count    // IN : slice of samples, count 0 for all
 ) {
     //Configure stuff
     cl_int err;
-    size_t msize = sizeX * sizeY * sizeZ * sizeW;
+    size_t msize = count ? count : sizeX * sizeY * sizeZ * sizeW - first;
 
     //Create buffers
     cl::Buffer buf_result(context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
     assert(err == CL_SUCCESS);
 
     //Prepare kernel
-    kernel.setArg(0, sizeof(Snapshot), &param);
-    kernel.setArg(1, sizeof(size_t), &sizeX);
-    kernel.setArg(2, sizeof(size_t), &sizeY);
-    kernel.setArg(3, sizeof(size_t), &sizeZ);
-    kernel.setArg(4, sizeof(size_t), &sizeW);
-    kernel.setArg(5, sizeof(float), &scaleX);
-    kernel.setArg(6, sizeof(float), &scaleY);
-    kernel.setArg(7, sizeof(float), &scaleZ);
-    kernel.setArg(8, sizeof(float), &scaleW);
-    kernel.setArg(9, sizeof(float), &offsetX);
-    kernel.setArg(10, sizeof(float), &offsetY);
-    kernel.setArg(11, sizeof(float), &offsetZ);
-    kernel.setArg(12, sizeof(float), &offsetW);
-    kernel.setArg(13, buf_result);
+    LaunchParams header = {};
+    header.m_size[0] = sizeX;
+    header.m_size[1] = sizeY;
+    header.m_size[2] = sizeZ;
+    header.m_size[3] = sizeW;
+    header.m_scale[0] = scaleX;
+    header.m_scale[1] = scaleY;
+    header.m_scale[2] = scaleZ;
+    header.m_scale[3] = scaleW;
+    header.m_offset[0] = offsetX;
+    header.m_offset[1] = offsetY;
+    header.m_offset[2] = offsetZ;
+    header.m_offset[3] = offsetW;
+    std::unique_lock<std::mutex> lock(launch.m_mutex);
+    launch.update(context, cmdQueue, header, &param, 1);
+    kernel.setArg(0, launch.m_buffer);
+    kernel.setArg(1, buf_result);
 
     //Execute task
-    err = cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    err = cmdQueue.enqueueNDRangeKernel(kernel, cl::NDRange(first), cl::NDRange(msize), cl::NullRange, &launch.m_waits);
     assert(err == CL_SUCCESS);
+    lock.unlock();
     err = cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
     assert(err == CL_SUCCESS);
 }
 
+//1D
+void KernelAdapter::GEN_Value1(
+    Snapshot param, // IN : class members
+
+    size_t sizeX,   // |
+    float scaleX,   // | IN : Parameters
+    float offsetX,  // |
+
+    float* result
+) {
+    cl::Kernel kernel(rimpl.m_kernels[VALUE1]);
+    exec_kernel_1D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, scaleX, offsetX, result, m_sliceFirst, m_sliceCount);
+}
+void KernelAdapter::GEN_ValueFractal1(
+    Snapshot param, // IN : class members
+
+    size_t sizeX,   // |
+    float scaleX,   // | IN : Parameters
+    float offsetX,  // |
+
+    float* result
+) {
+    cl::Kernel kernel(rimpl.m_kernels[VALUEFRACTAL1]);
+    exec_kernel_1D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, scaleX, offsetX, result, m_sliceFirst, m_sliceCount);
+}
+void KernelAdapter::GEN_Perlin1(
+    Snapshot param, // IN : class members
+
+    size_t sizeX,   // |
+    float scaleX,   // | IN : Parameters
+    float offsetX,  // |
+
+    float* result
+) {
+    cl::Kernel kernel(rimpl.m_kernels[PERLIN1]);
+    exec_kernel_1D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, scaleX, offsetX, result, m_sliceFirst, m_sliceCount);
+}
+void KernelAdapter::GEN_PerlinFractal1(
+    Snapshot param, // IN : class members
+
+    size_t sizeX,   // |
+    float scaleX,   // | IN : Parameters
+    float offsetX,  // |
+
+    float* result
+) {
+    cl::Kernel kernel(rimpl.m_kernels[PERLINFRACTAL1]);
+    exec_kernel_1D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, scaleX, offsetX, result, m_sliceFirst, m_sliceCount);
+}
+void KernelAdapter::GEN_Simplex1(
+    Snapshot param, // IN : class members
+
+    size_t sizeX,   // |
+    float scaleX,   // | IN : Parameters
+    float offsetX,  // |
+
+    float* result
+) {
+    cl::Kernel kernel(rimpl.m_kernels[SIMPLEX1]);
+    exec_kernel_1D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, scaleX, offsetX, result, m_sliceFirst, m_sliceCount);
+}
+void KernelAdapter::GEN_SimplexFractal1(
+    Snapshot param, // IN : class members
+
+    size_t sizeX,   // |
+    float scaleX,   // | IN : Parameters
+    float offsetX,  // |
+
+    float* result
+) {
+    cl::Kernel kernel(rimpl.m_kernels[SIMPLEXFRACTAL1]);
+    exec_kernel_1D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, scaleX, offsetX, result, m_sliceFirst, m_sliceCount);
+}
+
 //2D
 void KernelAdapter::GEN_Value2(
     Snapshot param,               // IN : class members
@@ -414,7 +746,7 @@ void KernelAdapter::GEN_Value2(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[VALUE2]);
-    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result);
+    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_ValueFractal2(
     Snapshot param,               // IN : class members
@@ -426,7 +758,7 @@ void KernelAdapter::GEN_ValueFractal2(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[VALUEFRACTAL2]);
-    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result);
+    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_Perlin2(
     Snapshot param,               // IN : class members
@@ -438,7 +770,7 @@ void KernelAdapter::GEN_Perlin2(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[PERLIN2]);
-    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result);
+    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_PerlinFractal2(
     Snapshot param,               // IN : class members
@@ -450,7 +782,7 @@ void KernelAdapter::GEN_PerlinFractal2(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[PERLINFRACTAL2]);
-    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result);
+    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_Simplex2(
     Snapshot param,               // IN : class members
@@ -462,7 +794,7 @@ void KernelAdapter::GEN_Simplex2(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[SIMPLEX2]);
-    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result);
+    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_SimplexFractal2(
     Snapshot param,               // IN : class members
@@ -474,7 +806,7 @@ void KernelAdapter::GEN_SimplexFractal2(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[SIMPLEXFRACTAL2]);
-    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result);
+    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_Cellular2(
     Snapshot param,               // IN : class members
@@ -486,7 +818,7 @@ void KernelAdapter::GEN_Cellular2(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[CELLULAR2]);
-    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result);
+    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_WhiteNoise2(
     Snapshot param,               // IN : class members
@@ -498,7 +830,7 @@ void KernelAdapter::GEN_WhiteNoise2(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[WHITENOISE2]);
-    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result);
+    exec_kernel_2D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, scaleX, scaleY, offsetX, offsetY, result, m_sliceFirst, m_sliceCount);
 }
 
 //3D
@@ -512,7 +844,7 @@ void KernelAdapter::GEN_Value3(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[VALUE3]);
-    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result);
+    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_ValueFractal3(
     Snapshot param,                              // IN : class members
@@ -524,7 +856,7 @@ void KernelAdapter::GEN_ValueFractal3(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[VALUEFRACTAL3]);
-    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result);
+    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_Perlin3(
     Snapshot param,                              // IN : class members
@@ -536,7 +868,7 @@ void KernelAdapter::GEN_Perlin3(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[PERLIN3]);
-    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result);
+    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_PerlinFractal3(
     Snapshot param,                              // IN : class members
@@ -548,7 +880,7 @@ void KernelAdapter::GEN_PerlinFractal3(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[PERLINFRACTAL3]);
-    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result);
+    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_Simplex3(
     Snapshot param,                              // IN : class members
@@ -560,7 +892,7 @@ void KernelAdapter::GEN_Simplex3(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[SIMPLEX3]);
-    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result);
+    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_SimplexFractal3(
     Snapshot param,                              // IN : class members
@@ -572,7 +904,7 @@ void KernelAdapter::GEN_SimplexFractal3(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[SIMPLEXFRACTAL3]);
-    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result);
+    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_Cellular3(
     Snapshot param,                              // IN : class members
@@ -584,7 +916,7 @@ void KernelAdapter::GEN_Cellular3(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[CELLULAR3]);
-    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result);
+    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_WhiteNoise3(
     Snapshot param,                              // IN : class members
@@ -596,7 +928,7 @@ void KernelAdapter::GEN_WhiteNoise3(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[WHITENOISE3]);
-    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result);
+    exec_kernel_3D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, sizeZ, scaleX, scaleY, scaleZ, offsetX, offsetY, offsetZ, result, m_sliceFirst, m_sliceCount);
 }
 
 //4D
@@ -610,7 +942,7 @@ void KernelAdapter::GEN_Simplex4(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[SIMPLEX4]);
-    exec_kernel_4D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, sizeZ, sizeW, scaleX, scaleY, scaleZ, scaleW, offsetX, offsetY, offsetZ, offsetW, result);
+    exec_kernel_4D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, sizeZ, sizeW, scaleX, scaleY, scaleZ, scaleW, offsetX, offsetY, offsetZ, offsetW, result, m_sliceFirst, m_sliceCount);
 }
 void KernelAdapter::GEN_WhiteNoise4(
     Snapshot param,                                             // IN : class members
@@ -622,7 +954,7 @@ void KernelAdapter::GEN_WhiteNoise4(
     float* result
 ) {
     cl::Kernel kernel(rimpl.m_kernels[WHITENOISE4]);
-    exec_kernel_4D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, param, sizeX, sizeY, sizeZ, sizeW, scaleX, scaleY, scaleZ, scaleW, offsetX, offsetY, offsetZ, offsetW, result);
+    exec_kernel_4D<float>(kernel, rimpl.m_context, rimpl.m_cmdQueue, *rimpl.m_launch, param, sizeX, sizeY, sizeZ, sizeW, scaleX, scaleY, scaleZ, scaleW, offsetX, offsetY, offsetZ, offsetW, result, m_sliceFirst, m_sliceCount);
 }
 
 //NoiseLookup
@@ -637,31 +969,32 @@ void KernelAdapter::GEN_Lookup_Cellular2(
 ) {
     //Configure stuff
     cl_int err;
-    size_t msize = sizeX * sizeY;
+    size_t msize = m_sliceCount ? m_sliceCount : sizeX * sizeY - m_sliceFirst;
 
     //Get CL objects
     cl::Kernel kernel(rimpl.m_kernels[LOOKUP_CELLULAR2]);
 
     //Create buffers
-    cl::Buffer buf_param(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(Snapshot) * size_p, params, &err);
-    assert(err == CL_SUCCESS);
     cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
     assert(err == CL_SUCCESS);
 
     //Prepare kernel
-    kernel.setArg(0, buf_param);
-    kernel.setArg(1, sizeof(size_t), &size_p);
-    kernel.setArg(2, sizeof(size_t), &sizeX);
-    kernel.setArg(3, sizeof(size_t), &sizeY);
-    kernel.setArg(4, sizeof(float), &scaleX);
-    kernel.setArg(5, sizeof(float), &scaleY);
-    kernel.setArg(6, sizeof(float), &offsetX);
-    kernel.setArg(7, sizeof(float), &offsetY);
-    kernel.setArg(8, buf_result);
+    LaunchParams header = {};
+    header.m_size[0] = sizeX;
+    header.m_size[1] = sizeY;
+    header.m_scale[0] = scaleX;
+    header.m_scale[1] = scaleY;
+    header.m_offset[0] = offsetX;
+    header.m_offset[1] = offsetY;
+    std::unique_lock<std::mutex> lock(rimpl.m_launch->m_mutex);
+    rimpl.m_launch->update(rimpl.m_context, rimpl.m_cmdQueue, header, params, size_p);
+    kernel.setArg(0, rimpl.m_launch->m_buffer);
+    kernel.setArg(1, buf_result);
 
     //Execute task
-    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NDRange(m_sliceFirst), cl::NDRange(msize), cl::NullRange, &rimpl.m_launch->m_waits);
     assert(err == CL_SUCCESS);
+    lock.unlock();
     err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
     assert(err == CL_SUCCESS);
 }
@@ -676,30 +1009,274 @@ void KernelAdapter::GEN_Lookup_Cellular3(
 ) {
     //Configure stuff
     cl_int err;
-    size_t msize = sizeX * sizeY * sizeZ;
+    size_t msize = m_sliceCount ? m_sliceCount : sizeX * sizeY * sizeZ - m_sliceFirst;
 
     //Get CL objects
     cl::Kernel kernel(rimpl.m_kernels[LOOKUP_CELLULAR3]);
 
+    //Create buffers
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    LaunchParams header = {};
+    header.m_size[0] = sizeX;
+    header.m_size[1] = sizeY;
+    header.m_size[2] = sizeZ;
+    header.m_scale[0] = scaleX;
+    header.m_scale[1] = scaleY;
+    header.m_scale[2] = scaleZ;
+    header.m_offset[0] = offsetX;
+    header.m_offset[1] = offsetY;
+    header.m_offset[2] = offsetZ;
+    std::unique_lock<std::mutex> lock(rimpl.m_launch->m_mutex);
+    rimpl.m_launch->update(rimpl.m_context, rimpl.m_cmdQueue, header, params, size_p);
+    kernel.setArg(0, rimpl.m_launch->m_buffer);
+    kernel.setArg(1, buf_result);
+
+    //Execute task
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NDRange(m_sliceFirst), cl::NDRange(msize), cl::NullRange, &rimpl.m_launch->m_waits);
+    assert(err == CL_SUCCESS);
+    lock.unlock();
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
+
+//Tiles
+void KernelAdapter::GEN_Tiles2(
+    Snapshot param,               // IN : class members
+
+    float* tiles, size_t count,   // IN : offsetX, offsetY, scaleX, scaleY of every tile
+    size_t sizeX, size_t sizeY,   // IN : size of one tile
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY * count;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[TILES2]);
+
+    //Create buffers
+    cl::Buffer buf_tiles(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * 4 * count, tiles, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, buf_tiles);
+    kernel.setArg(2, sizeof(size_t), &sizeX);
+    kernel.setArg(3, sizeof(size_t), &sizeY);
+    kernel.setArg(4, buf_result);
+
+    //Execute task
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
+
+//Boxes
+#define BOX_STRIDE 7 // Same as BOX_STRIDE in Noise.cl
+
+void KernelAdapter::GEN_Boxes3(
+    Snapshot param,               // IN : class members
+
+    float* origins,               // IN : originX, originY, originZ, step of every box
+    long long* boxes,             // IN : startX, startY, startZ, sizeX, sizeY, sizeZ of every box
+    size_t count,
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+    std::vector<cl_long> layout(count * BOX_STRIDE);
+    size_t msize = 0;
+    for (size_t b = 0; b < count; b++) {
+        for (int a = 0; a < 6; a++) layout[b * BOX_STRIDE + a] = boxes[b * 6 + a];
+        layout[b * BOX_STRIDE + 6] = msize;
+        msize += boxes[b * 6 + 3] * boxes[b * 6 + 4] * boxes[b * 6 + 5];
+    }
+    cl_ulong boxCount = count;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[BOXES3]);
+
+    //Create buffers
+    cl::Buffer buf_origins(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * 4 * count, origins, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_boxes(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(cl_long) * layout.size(), layout.data(), &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, buf_origins);
+    kernel.setArg(2, buf_boxes);
+    kernel.setArg(3, sizeof(cl_ulong), &boxCount);
+    kernel.setArg(4, buf_result);
+
+    //Execute task
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
+
+//Biomes
+/*
+ * Sorts one slice of samples by biome of own cell on device
+ *   Returns buffer of sizeX * sizeY slice indices grouped by biome, so no per-sample order is uploaded
+ */
+cl::Buffer sort_biomes(
+    cl::Kernel* kernels,          // |
+    cl::Context& context,         // | IN : KernelAdapter::impl
+    cl::CommandQueue& cmdQueue,   // |
+
+    cl::Buffer& buf_biomes, size_t mapX, size_t mapY, size_t cell, // IN : Biome map
+    size_t sizeX, size_t sizeY    // IN : slice size
+) {
+    cl_int err;
+    size_t plane = sizeX * sizeY;
+
+    cl::Buffer buf_counts(context, CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(cl_uint) * 256, nullptr, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_order(context, CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(cl_uint) * plane, nullptr, &err);
+    assert(err == CL_SUCCESS);
+    err = cmdQueue.enqueueFillBuffer(buf_counts, (cl_uint)0, 0, sizeof(cl_uint) * 256);
+    assert(err == CL_SUCCESS);
+
+    //Count, scan and scatter stay on device in queue order
+    cl::Kernel count(kernels[BIOME_COUNT]);
+    count.setArg(0, buf_biomes);
+    count.setArg(1, sizeof(size_t), &mapX);
+    count.setArg(2, sizeof(size_t), &mapY);
+    count.setArg(3, sizeof(size_t), &cell);
+    count.setArg(4, sizeof(size_t), &sizeY);
+    count.setArg(5, buf_counts);
+    err = cmdQueue.enqueueNDRangeKernel(count, cl::NullRange, cl::NDRange(plane));
+    assert(err == CL_SUCCESS);
+
+    cl::Kernel scan(kernels[BIOME_SCAN]);
+    scan.setArg(0, buf_counts);
+    err = cmdQueue.enqueueNDRangeKernel(scan, cl::NullRange, cl::NDRange(1));
+    assert(err == CL_SUCCESS);
+
+    cl::Kernel scatter(kernels[BIOME_SCATTER]);
+    scatter.setArg(0, buf_biomes);
+    scatter.setArg(1, sizeof(size_t), &mapX);
+    scatter.setArg(2, sizeof(size_t), &mapY);
+    scatter.setArg(3, sizeof(size_t), &cell);
+    scatter.setArg(4, sizeof(size_t), &sizeY);
+    scatter.setArg(5, buf_counts);
+    scatter.setArg(6, buf_order);
+    err = cmdQueue.enqueueNDRangeKernel(scatter, cl::NullRange, cl::NDRange(plane));
+    assert(err == CL_SUCCESS);
+
+    return buf_order;
+}
+
+void KernelAdapter::GEN_Biome2(
+    Snapshot* params, size_t size_p,                     // IN : members of every biome
+
+    unsigned char* biomes, size_t mapX, size_t mapY,     // |
+    size_t cell, float blend,                            // | IN : Biome map
+
+    size_t sizeX, size_t sizeY,                          // |
+    float scaleX, float scaleY,                          // | IN : Parameters
+    float offsetX, float offsetY,                        // |
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[BIOME2]);
+
     //Create buffers
     cl::Buffer buf_param(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(Snapshot) * size_p, params, &err);
     assert(err == CL_SUCCESS);
+    cl::Buffer buf_biomes(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(unsigned char) * mapX * mapY, biomes, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_order = sort_biomes(rimpl.m_kernels, rimpl.m_context, rimpl.m_cmdQueue, buf_biomes, mapX, mapY, cell, sizeX, sizeY);
     cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
     assert(err == CL_SUCCESS);
 
     //Prepare kernel
     kernel.setArg(0, buf_param);
     kernel.setArg(1, sizeof(size_t), &size_p);
-    kernel.setArg(2, sizeof(size_t), &sizeX);
-    kernel.setArg(3, sizeof(size_t), &sizeY);
-    kernel.setArg(4, sizeof(size_t), &sizeZ);
-    kernel.setArg(5, sizeof(float), &scaleX);
-    kernel.setArg(6, sizeof(float), &scaleY);
-    kernel.setArg(7, sizeof(float), &scaleZ);
-    kernel.setArg(8, sizeof(float), &offsetX);
-    kernel.setArg(9, sizeof(float), &offsetY);
-    kernel.setArg(10, sizeof(float), &offsetZ);
-    kernel.setArg(11, buf_result);
+    kernel.setArg(2, buf_biomes);
+    kernel.setArg(3, sizeof(size_t), &mapX);
+    kernel.setArg(4, sizeof(size_t), &mapY);
+    kernel.setArg(5, sizeof(size_t), &cell);
+    kernel.setArg(6, sizeof(float), &blend);
+    kernel.setArg(7, buf_order);
+    kernel.setArg(8, sizeof(size_t), &sizeX);
+    kernel.setArg(9, sizeof(size_t), &sizeY);
+    kernel.setArg(10, sizeof(float), &scaleX);
+    kernel.setArg(11, sizeof(float), &scaleY);
+    kernel.setArg(12, sizeof(float), &offsetX);
+    kernel.setArg(13, sizeof(float), &offsetY);
+    kernel.setArg(14, buf_result);
+
+    //Execute task
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
+void KernelAdapter::GEN_Biome3(
+    Snapshot* params, size_t size_p,                     // IN : members of every biome
+
+    unsigned char* biomes, size_t mapX, size_t mapY,     // |
+    size_t cell, float blend,                            // | IN : Biome map
+
+    size_t sizeX, size_t sizeY, size_t sizeZ,            // |
+    float scaleX, float scaleY, float scaleZ,            // | IN : Parameters
+    float offsetX, float offsetY, float offsetZ,         // |
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY * sizeZ;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[BIOME3]);
+
+    //Create buffers
+    cl::Buffer buf_param(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(Snapshot) * size_p, params, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_biomes(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(unsigned char) * mapX * mapY, biomes, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_order = sort_biomes(rimpl.m_kernels, rimpl.m_context, rimpl.m_cmdQueue, buf_biomes, mapX, mapY, cell, sizeX, sizeY);
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, buf_param);
+    kernel.setArg(1, sizeof(size_t), &size_p);
+    kernel.setArg(2, buf_biomes);
+    kernel.setArg(3, sizeof(size_t), &mapX);
+    kernel.setArg(4, sizeof(size_t), &mapY);
+    kernel.setArg(5, sizeof(size_t), &cell);
+    kernel.setArg(6, sizeof(float), &blend);
+    kernel.setArg(7, buf_order);
+    kernel.setArg(8, sizeof(size_t), &sizeX);
+    kernel.setArg(9, sizeof(size_t), &sizeY);
+    kernel.setArg(10, sizeof(size_t), &sizeZ);
+    kernel.setArg(11, sizeof(float), &scaleX);
+    kernel.setArg(12, sizeof(float), &scaleY);
+    kernel.setArg(13, sizeof(float), &scaleZ);
+    kernel.setArg(14, sizeof(float), &offsetX);
+    kernel.setArg(15, sizeof(float), &offsetY);
+    kernel.setArg(16, sizeof(float), &offsetZ);
+    kernel.setArg(17, buf_result);
 
     //Execute task
     err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
@@ -707,3 +1284,1193 @@ void KernelAdapter::GEN_Lookup_Cellular3(
     err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
     assert(err == CL_SUCCESS);
 }
+
+//Octaves
+void KernelAdapter::GEN_Octaves2(
+    Snapshot param,               // IN : class members
+    int first, int last,          // IN : octaves [first, last)
+
+    size_t sizeX, size_t sizeY,   // |
+    float scaleX, float scaleY,   // | IN : Parameters
+    float offsetX, float offsetY, // |
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[OCTAVES2]);
+
+    //Create buffers
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_WRITE, sizeof(float) * msize, result, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, sizeof(int), &first);
+    kernel.setArg(2, sizeof(int), &last);
+    kernel.setArg(3, sizeof(size_t), &sizeX);
+    kernel.setArg(4, sizeof(size_t), &sizeY);
+    kernel.setArg(5, sizeof(float), &scaleX);
+    kernel.setArg(6, sizeof(float), &scaleY);
+    kernel.setArg(7, sizeof(float), &offsetX);
+    kernel.setArg(8, sizeof(float), &offsetY);
+    kernel.setArg(9, buf_result);
+
+    //Execute task
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
+void KernelAdapter::GEN_Octaves3(
+    Snapshot param,                              // IN : class members
+    int first, int last,                         // IN : octaves [first, last)
+
+    size_t sizeX, size_t sizeY, size_t sizeZ,    // |
+    float scaleX, float scaleY, float scaleZ,    // | IN : Parameters
+    float offsetX, float offsetY, float offsetZ, // |
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY * sizeZ;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[OCTAVES3]);
+
+    //Create buffers
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_WRITE, sizeof(float) * msize, result, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, sizeof(int), &first);
+    kernel.setArg(2, sizeof(int), &last);
+    kernel.setArg(3, sizeof(size_t), &sizeX);
+    kernel.setArg(4, sizeof(size_t), &sizeY);
+    kernel.setArg(5, sizeof(size_t), &sizeZ);
+    kernel.setArg(6, sizeof(float), &scaleX);
+    kernel.setArg(7, sizeof(float), &scaleY);
+    kernel.setArg(8, sizeof(float), &scaleZ);
+    kernel.setArg(9, sizeof(float), &offsetX);
+    kernel.setArg(10, sizeof(float), &offsetY);
+    kernel.setArg(11, sizeof(float), &offsetZ);
+    kernel.setArg(12, buf_result);
+
+    //Execute task
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
+
+//Mesh
+void KernelAdapter::GEN_Mesh3(
+    Snapshot param,                                       // IN : class members
+    float scale,                                          // IN : displacement per unit of noise
+
+    float* positions, float* normals, size_t vertexCount, // IN : 3 floats per vertex
+    unsigned int* indices, size_t faceCount,              // IN : 3 vertices per triangle
+    unsigned int* offsets, unsigned int* faces,           // IN : triangles of every vertex
+
+    float* resultPositions, float* resultNormals
+) {
+    //Configure stuff
+    cl_int err;
+    size_t vsize = vertexCount * 3;
+    size_t fsize = faceCount * 3;
+
+    //Get CL objects
+    cl::Kernel displace(rimpl.m_kernels[DISPLACE3]);
+    cl::Kernel faceNormals(rimpl.m_kernels[FACENORMALS3]);
+    cl::Kernel vertexNormals(rimpl.m_kernels[VERTEXNORMALS3]);
+
+    //Create buffers
+    cl::Buffer buf_positions(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * vsize, positions, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_normals(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * vsize, normals, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_indices(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(unsigned int) * fsize, indices, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_offsets(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(unsigned int) * (vertexCount + 1), offsets, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_faces(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(unsigned int) * fsize, faces, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_displaced(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_READ_ONLY, sizeof(float) * vsize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_faceNormals(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(float) * fsize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * vsize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    displace.setArg(0, sizeof(Snapshot), &param);
+    displace.setArg(1, sizeof(float), &scale);
+    displace.setArg(2, buf_positions);
+    displace.setArg(3, buf_normals);
+    displace.setArg(4, buf_displaced);
+
+    faceNormals.setArg(0, buf_indices);
+    faceNormals.setArg(1, buf_displaced);
+    faceNormals.setArg(2, buf_faceNormals);
+
+    vertexNormals.setArg(0, buf_offsets);
+    vertexNormals.setArg(1, buf_faces);
+    vertexNormals.setArg(2, buf_faceNormals);
+    vertexNormals.setArg(3, buf_normals);
+    vertexNormals.setArg(4, buf_result);
+
+    //Execute task, stages stay on device in queue order
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(displace, cl::NullRange, cl::NDRange(vertexCount));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(faceNormals, cl::NullRange, cl::NDRange(faceCount));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(vertexNormals, cl::NullRange, cl::NDRange(vertexCount));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_displaced, CL_FALSE, 0, sizeof(float) * vsize, resultPositions);
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * vsize, resultNormals);
+    assert(err == CL_SUCCESS);
+}
+
+//Points
+void KernelAdapter::GEN_Points2(
+    Snapshot param,               // IN : class members
+    float* points, size_t count,  // IN : 2 floats per point
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[POINTS2]);
+
+    //Create buffers
+    cl::Buffer buf_points(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * 2 * count, points, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * count, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, buf_points);
+    kernel.setArg(2, buf_result);
+
+    //Execute task
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(count));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * count, result);
+    assert(err == CL_SUCCESS);
+}
+void KernelAdapter::GEN_Points3(
+    Snapshot param,               // IN : class members
+    float* points, size_t count,  // IN : 3 floats per point
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[POINTS3]);
+
+    //Create buffers
+    cl::Buffer buf_points(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * 3 * count, points, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * count, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, buf_points);
+    kernel.setArg(2, buf_result);
+
+    //Execute task
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(count));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * count, result);
+    assert(err == CL_SUCCESS);
+}
+
+//Approximate perturb
+void KernelAdapter::GEN_PerturbApprox2(
+    Snapshot param,               // IN : class members
+    size_t factor,                // IN : samples per coarse cell along each axis
+
+    size_t sizeX, size_t sizeY,   // |
+    float scaleX, float scaleY,   // | IN : Parameters
+    float offsetX, float offsetY, // |
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY;
+    size_t fieldX = (sizeX - 1) / factor + 2, fieldY = (sizeY - 1) / factor + 2;
+    size_t fsize = fieldX * fieldY;
+    float fieldScaleX = scaleX * factor, fieldScaleY = scaleY * factor;
+
+    //Get CL objects
+    cl::Kernel field(rimpl.m_kernels[PERTURBFIELD2]);
+    cl::Kernel kernel(rimpl.m_kernels[PERTURBAPPROX2]);
+
+    //Create buffers
+    cl::Buffer buf_field(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(float) * 2 * fsize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    field.setArg(0, sizeof(Snapshot), &param);
+    field.setArg(1, sizeof(size_t), &fieldX);
+    field.setArg(2, sizeof(size_t), &fieldY);
+    field.setArg(3, sizeof(float), &fieldScaleX);
+    field.setArg(4, sizeof(float), &fieldScaleY);
+    field.setArg(5, sizeof(float), &offsetX);
+    field.setArg(6, sizeof(float), &offsetY);
+    field.setArg(7, buf_field);
+
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, sizeof(size_t), &factor);
+    kernel.setArg(2, buf_field);
+    kernel.setArg(3, sizeof(size_t), &sizeX);
+    kernel.setArg(4, sizeof(size_t), &sizeY);
+    kernel.setArg(5, sizeof(float), &scaleX);
+    kernel.setArg(6, sizeof(float), &scaleY);
+    kernel.setArg(7, sizeof(float), &offsetX);
+    kernel.setArg(8, sizeof(float), &offsetY);
+    kernel.setArg(9, buf_result);
+
+    //Execute task, field stays on device
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(field, cl::NullRange, cl::NDRange(fsize));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
+void KernelAdapter::GEN_PerturbApprox3(
+    Snapshot param,                              // IN : class members
+    size_t factor,                               // IN : samples per coarse cell along each axis
+
+    size_t sizeX, size_t sizeY, size_t sizeZ,    // |
+    float scaleX, float scaleY, float scaleZ,    // | IN : Parameters
+    float offsetX, float offsetY, float offsetZ, // |
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY * sizeZ;
+    size_t fieldX = (sizeX - 1) / factor + 2, fieldY = (sizeY - 1) / factor + 2, fieldZ = (sizeZ - 1) / factor + 2;
+    size_t fsize = fieldX * fieldY * fieldZ;
+    float fieldScaleX = scaleX * factor, fieldScaleY = scaleY * factor, fieldScaleZ = scaleZ * factor;
+
+    //Get CL objects
+    cl::Kernel field(rimpl.m_kernels[PERTURBFIELD3]);
+    cl::Kernel kernel(rimpl.m_kernels[PERTURBAPPROX3]);
+
+    //Create buffers
+    cl::Buffer buf_field(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(float) * 3 * fsize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    field.setArg(0, sizeof(Snapshot), &param);
+    field.setArg(1, sizeof(size_t), &fieldX);
+    field.setArg(2, sizeof(size_t), &fieldY);
+    field.setArg(3, sizeof(size_t), &fieldZ);
+    field.setArg(4, sizeof(float), &fieldScaleX);
+    field.setArg(5, sizeof(float), &fieldScaleY);
+    field.setArg(6, sizeof(float), &fieldScaleZ);
+    field.setArg(7, sizeof(float), &offsetX);
+    field.setArg(8, sizeof(float), &offsetY);
+    field.setArg(9, sizeof(float), &offsetZ);
+    field.setArg(10, buf_field);
+
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, sizeof(size_t), &factor);
+    kernel.setArg(2, buf_field);
+    kernel.setArg(3, sizeof(size_t), &sizeX);
+    kernel.setArg(4, sizeof(size_t), &sizeY);
+    kernel.setArg(5, sizeof(size_t), &sizeZ);
+    kernel.setArg(6, sizeof(float), &scaleX);
+    kernel.setArg(7, sizeof(float), &scaleY);
+    kernel.setArg(8, sizeof(float), &scaleZ);
+    kernel.setArg(9, sizeof(float), &offsetX);
+    kernel.setArg(10, sizeof(float), &offsetY);
+    kernel.setArg(11, sizeof(float), &offsetZ);
+    kernel.setArg(12, buf_result);
+
+    //Execute task, field stays on device
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(field, cl::NullRange, cl::NDRange(fsize));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
+
+//Levels
+void KernelAdapter::GEN_Levels2(
+    Snapshot param,               // IN : class members
+    float* coarse,                // IN : level 0
+
+    size_t sizeX, size_t sizeY,   // |
+    float scaleX, float scaleY,   // | IN : Parameters of level 0
+    float offsetX, float offsetY, // |
+
+    size_t levels, float** results // OUT : levels 1 to levels
+) {
+    //Configure stuff
+    cl_int err;
+    size_t csize = sizeX * sizeY;
+
+    //Get CL objects
+    cl::Kernel inject(rimpl.m_kernels[INJECT2]);
+    cl::Kernel kernel(rimpl.m_kernels[REFINE2]);
+
+    //Create buffers, every level stays on device as coarse input of the next one
+    cl::Buffer buf_coarse(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_WRITE | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * csize, coarse, &err);
+    assert(err == CL_SUCCESS);
+
+    for (size_t l = 0; l < levels; l++) {
+        // Halved steps put every even sample exactly on the previous level
+        size_t coarseY = sizeY;
+        sizeX = (sizeX - 1) * 2 + 1;
+        sizeY = (sizeY - 1) * 2 + 1;
+        scaleX *= 0.5f;
+        scaleY *= 0.5f;
+        size_t msize = sizeX * sizeY;
+
+        cl::Buffer buf_result(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+        assert(err == CL_SUCCESS);
+
+        //Prepare kernel
+        inject.setArg(0, sizeof(size_t), &coarseY);
+        inject.setArg(1, sizeof(size_t), &sizeY);
+        inject.setArg(2, buf_coarse);
+        inject.setArg(3, buf_result);
+
+        kernel.setArg(0, sizeof(Snapshot), &param);
+        kernel.setArg(1, sizeof(size_t), &sizeX);
+        kernel.setArg(2, sizeof(size_t), &sizeY);
+        kernel.setArg(3, sizeof(float), &scaleX);
+        kernel.setArg(4, sizeof(float), &scaleY);
+        kernel.setArg(5, sizeof(float), &offsetX);
+        kernel.setArg(6, sizeof(float), &offsetY);
+        kernel.setArg(7, buf_result);
+
+        //Execute task, only samples without coarse value are evaluated
+        err = rimpl.m_cmdQueue.enqueueNDRangeKernel(inject, cl::NullRange, cl::NDRange(csize));
+        assert(err == CL_SUCCESS);
+        if (msize > csize) {
+            err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize - csize));
+            assert(err == CL_SUCCESS);
+        }
+        err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_FALSE, 0, sizeof(float) * msize, results[l]);
+        assert(err == CL_SUCCESS);
+
+        buf_coarse = buf_result;
+        csize = msize;
+    }
+
+    err = rimpl.m_cmdQueue.finish();
+    assert(err == CL_SUCCESS);
+}
+void KernelAdapter::GEN_Levels3(
+    Snapshot param,                              // IN : class members
+    float* coarse,                               // IN : level 0
+
+    size_t sizeX, size_t sizeY, size_t sizeZ,    // |
+    float scaleX, float scaleY, float scaleZ,    // | IN : Parameters of level 0
+    float offsetX, float offsetY, float offsetZ, // |
+
+    size_t levels, float** results               // OUT : levels 1 to levels
+) {
+    //Configure stuff
+    cl_int err;
+    size_t csize = sizeX * sizeY * sizeZ;
+
+    //Get CL objects
+    cl::Kernel inject(rimpl.m_kernels[INJECT3]);
+    cl::Kernel kernel(rimpl.m_kernels[REFINE3]);
+
+    //Create buffers, every level stays on device as coarse input of the next one
+    cl::Buffer buf_coarse(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_WRITE | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * csize, coarse, &err);
+    assert(err == CL_SUCCESS);
+
+    for (size_t l = 0; l < levels; l++) {
+        // Halved steps put every even sample exactly on the previous level
+        size_t coarseX = sizeX, coarseY = sizeY;
+        sizeX = (sizeX - 1) * 2 + 1;
+        sizeY = (sizeY - 1) * 2 + 1;
+        sizeZ = (sizeZ - 1) * 2 + 1;
+        scaleX *= 0.5f;
+        scaleY *= 0.5f;
+        scaleZ *= 0.5f;
+        size_t msize = sizeX * sizeY * sizeZ;
+
+        cl::Buffer buf_result(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+        assert(err == CL_SUCCESS);
+
+        //Prepare kernel
+        inject.setArg(0, sizeof(size_t), &coarseX);
+        inject.setArg(1, sizeof(size_t), &coarseY);
+        inject.setArg(2, sizeof(size_t), &sizeX);
+        inject.setArg(3, sizeof(size_t), &sizeY);
+        inject.setArg(4, buf_coarse);
+        inject.setArg(5, buf_result);
+
+        kernel.setArg(0, sizeof(Snapshot), &param);
+        kernel.setArg(1, sizeof(size_t), &sizeX);
+        kernel.setArg(2, sizeof(size_t), &sizeY);
+        kernel.setArg(3, sizeof(size_t), &sizeZ);
+        kernel.setArg(4, sizeof(float), &scaleX);
+        kernel.setArg(5, sizeof(float), &scaleY);
+        kernel.setArg(6, sizeof(float), &scaleZ);
+        kernel.setArg(7, sizeof(float), &offsetX);
+        kernel.setArg(8, sizeof(float), &offsetY);
+        kernel.setArg(9, sizeof(float), &offsetZ);
+        kernel.setArg(10, buf_result);
+
+        //Execute task, only samples without coarse value are evaluated
+        err = rimpl.m_cmdQueue.enqueueNDRangeKernel(inject, cl::NullRange, cl::NDRange(csize));
+        assert(err == CL_SUCCESS);
+        if (msize > csize) {
+            err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize - csize));
+            assert(err == CL_SUCCESS);
+        }
+        err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_FALSE, 0, sizeof(float) * msize, results[l]);
+        assert(err == CL_SUCCESS);
+
+        buf_coarse = buf_result;
+        csize = msize;
+    }
+
+    err = rimpl.m_cmdQueue.finish();
+    assert(err == CL_SUCCESS);
+}
+
+//Axis grids
+void KernelAdapter::GEN_Grid2(
+    Snapshot param,               // IN : class members
+
+    size_t sizeX, size_t sizeY,   // |
+    float* axes,                  // | IN : x coordinates followed by y coordinates
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[GRID2]);
+
+    //Create buffers
+    cl::Buffer buf_axes(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * (sizeX + sizeY), axes, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, sizeof(size_t), &sizeX);
+    kernel.setArg(2, sizeof(size_t), &sizeY);
+    kernel.setArg(3, buf_axes);
+    kernel.setArg(4, buf_result);
+
+    //Execute task
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
+void KernelAdapter::GEN_Grid3(
+    Snapshot param,                           // IN : class members
+
+    size_t sizeX, size_t sizeY, size_t sizeZ, // |
+    float* axes,                              // | IN : x coordinates followed by y and z coordinates
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY * sizeZ;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[GRID3]);
+
+    //Create buffers
+    cl::Buffer buf_axes(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * (sizeX + sizeY + sizeZ), axes, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, sizeof(size_t), &sizeX);
+    kernel.setArg(2, sizeof(size_t), &sizeY);
+    kernel.setArg(3, sizeof(size_t), &sizeZ);
+    kernel.setArg(4, buf_axes);
+    kernel.setArg(5, buf_result);
+
+    //Execute task
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
+
+//Block compression
+void KernelAdapter::GEN_BC4(
+    Snapshot param,               // IN : class members
+
+    size_t sizeX, size_t sizeY,   // |
+    float scaleX, float scaleY,   // | IN : Parameters
+    float offsetX, float offsetY, // |
+
+    float low, float high,        // IN : range mapped to 0 - 255
+    int quality,                  // IN : endpoint candidates per block
+
+    unsigned char* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t count = ((sizeX + 3) / 4) * ((sizeY + 3) / 4);
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[BC4]);
+
+    //Create buffers
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, 8 * count, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, sizeof(size_t), &sizeX);
+    kernel.setArg(2, sizeof(size_t), &sizeY);
+    kernel.setArg(3, sizeof(float), &scaleX);
+    kernel.setArg(4, sizeof(float), &scaleY);
+    kernel.setArg(5, sizeof(float), &offsetX);
+    kernel.setArg(6, sizeof(float), &offsetY);
+    kernel.setArg(7, sizeof(float), &low);
+    kernel.setArg(8, sizeof(float), &high);
+    kernel.setArg(9, sizeof(int), &quality);
+    kernel.setArg(10, buf_result);
+
+    //Execute task, one work item per block
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(count));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, 8 * count, result);
+    assert(err == CL_SUCCESS);
+}
+void KernelAdapter::GEN_BC5(
+    Snapshot red, Snapshot green, // IN : class members of both channels
+
+    size_t sizeX, size_t sizeY,   // |
+    float scaleX, float scaleY,   // | IN : Parameters
+    float offsetX, float offsetY, // |
+
+    float low, float high,        // IN : range mapped to 0 - 255
+    int quality,                  // IN : endpoint candidates per block
+
+    unsigned char* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t count = ((sizeX + 3) / 4) * ((sizeY + 3) / 4);
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[BC5]);
+
+    //Create buffers
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, 16 * count, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &red);
+    kernel.setArg(1, sizeof(Snapshot), &green);
+    kernel.setArg(2, sizeof(size_t), &sizeX);
+    kernel.setArg(3, sizeof(size_t), &sizeY);
+    kernel.setArg(4, sizeof(float), &scaleX);
+    kernel.setArg(5, sizeof(float), &scaleY);
+    kernel.setArg(6, sizeof(float), &offsetX);
+    kernel.setArg(7, sizeof(float), &offsetY);
+    kernel.setArg(8, sizeof(float), &low);
+    kernel.setArg(9, sizeof(float), &high);
+    kernel.setArg(10, sizeof(int), &quality);
+    kernel.setArg(11, buf_result);
+
+    //Execute task, one work item per block
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(count));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, 16 * count, result);
+    assert(err == CL_SUCCESS);
+}
+
+//Selection
+#define SEL_LOCAL_SIZE 256
+#define SEL_MAX_GROUPS 1024
+
+float key_float(unsigned int key) {
+    unsigned int u = (key & 0x80000000u) ? (key & 0x7fffffffu) : ~key;
+    float f;
+    memcpy(&f, &u, sizeof(float));
+    return f;
+}
+void select_field(
+    cl::Kernel* kernels,          // |
+    cl::Context& context,         // | IN : KernelAdapter::impl
+    cl::CommandQueue& cmdQueue,   // |
+
+    cl::Buffer& data, size_t size, // IN : generated samples on device
+
+    float* fractions, size_t count,
+    float* thresholds,
+    unsigned char* mask
+) {
+    //Configure stuff
+    cl_int err;
+    size_t groups = std::min((size + SEL_LOCAL_SIZE - 1) / SEL_LOCAL_SIZE, (size_t)SEL_MAX_GROUPS);
+    std::vector<cl_uint> first(256), bins(256);
+
+    //Get CL objects
+    cl::Kernel histogram(kernels[SEL_HISTOGRAM]);
+
+    //Create buffers
+    cl::Buffer buf_bins(context, CL_MEM_READ_WRITE, sizeof(cl_uint) * 256, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    auto pass = [&](cl_uint prefix, cl_uint keyMask, cl_int shift, std::vector<cl_uint>& result) {
+        err = cmdQueue.enqueueFillBuffer(buf_bins, (cl_uint)0, 0, sizeof(cl_uint) * 256);
+        assert(err == CL_SUCCESS);
+
+        histogram.setArg(0, data);
+        histogram.setArg(1, sizeof(size_t), &size);
+        histogram.setArg(2, sizeof(cl_uint), &prefix);
+        histogram.setArg(3, sizeof(cl_uint), &keyMask);
+        histogram.setArg(4, sizeof(cl_int), &shift);
+        histogram.setArg(5, buf_bins);
+
+        err = cmdQueue.enqueueNDRangeKernel(histogram, cl::NullRange, cl::NDRange(groups * SEL_LOCAL_SIZE), cl::NDRange(SEL_LOCAL_SIZE));
+        assert(err == CL_SUCCESS);
+        err = cmdQueue.enqueueReadBuffer(buf_bins, CL_TRUE, 0, sizeof(cl_uint) * 256, result.data());
+        assert(err == CL_SUCCESS);
+    };
+
+    //Execute task, radix select 8 bits at a time, top digit is shared by every fraction
+    pass(0, 0, 24, first);
+    for (size_t f = 0; f < count; f++) {
+        float fraction = std::min(std::max(fractions[f], 0.0f), 1.0f);
+        size_t rank = std::min((size_t)(fraction * size), size - 1);
+
+        cl_uint prefix = 0, keyMask = 0;
+        for (cl_int shift = 24; shift >= 0; shift -= 8) {
+            if (shift != 24) pass(prefix, keyMask, shift, bins);
+            const std::vector<cl_uint>& h = shift == 24 ? first : bins;
+
+            cl_uint b = 0;
+            while (b < 255 && rank >= h[b]) rank -= h[b++];
+            prefix |= b << shift;
+            keyMask |= 255u << shift;
+        }
+        thresholds[f] = key_float(prefix);
+    }
+
+    if (mask && count) {
+        cl::Kernel kernel(kernels[SEL_MASK]);
+        cl::Buffer buf_mask(context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, size, nullptr, &err);
+        assert(err == CL_SUCCESS);
+
+        kernel.setArg(0, data);
+        kernel.setArg(1, sizeof(float), &thresholds[0]);
+        kernel.setArg(2, buf_mask);
+
+        err = cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(size));
+        assert(err == CL_SUCCESS);
+        err = cmdQueue.enqueueReadBuffer(buf_mask, CL_TRUE, 0, size, mask);
+        assert(err == CL_SUCCESS);
+    }
+}
+void KernelAdapter::SEL_Select2(
+    Snapshot param,               // IN : class members
+
+    size_t sizeX, size_t sizeY,   // |
+    float scaleX, float scaleY,   // | IN : Parameters
+    float offsetX, float offsetY, // |
+
+    float* fractions, size_t count,
+    float* thresholds,
+    unsigned char* mask
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY;
+
+    //Get CL objects, 2D kernels are ordered like NoiseType
+    cl::Kernel kernel(rimpl.m_kernels[VALUE2 + param.m_noiseType]);
+
+    //Create buffers
+    cl::Buffer buf_data(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    LaunchParams header = {};
+    header.m_size[0] = sizeX;
+    header.m_size[1] = sizeY;
+    header.m_scale[0] = scaleX;
+    header.m_scale[1] = scaleY;
+    header.m_offset[0] = offsetX;
+    header.m_offset[1] = offsetY;
+    std::unique_lock<std::mutex> lock(rimpl.m_launch->m_mutex);
+    rimpl.m_launch->update(rimpl.m_context, rimpl.m_cmdQueue, header, &param, 1);
+    kernel.setArg(0, rimpl.m_launch->m_buffer);
+    kernel.setArg(1, buf_data);
+
+    //Execute task, samples stay on device
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize), cl::NullRange, &rimpl.m_launch->m_waits);
+    assert(err == CL_SUCCESS);
+    lock.unlock();
+    select_field(rimpl.m_kernels, rimpl.m_context, rimpl.m_cmdQueue, buf_data, msize, fractions, count, thresholds, mask);
+}
+void KernelAdapter::SEL_Select3(
+    Snapshot param,                              // IN : class members
+
+    size_t sizeX, size_t sizeY, size_t sizeZ,    // |
+    float scaleX, float scaleY, float scaleZ,    // | IN : Parameters
+    float offsetX, float offsetY, float offsetZ, // |
+
+    float* fractions, size_t count,
+    float* thresholds,
+    unsigned char* mask
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY * sizeZ;
+
+    //Get CL objects, 3D kernels are ordered like NoiseType
+    cl::Kernel kernel(rimpl.m_kernels[VALUE3 + param.m_noiseType]);
+
+    //Create buffers
+    cl::Buffer buf_data(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    LaunchParams header = {};
+    header.m_size[0] = sizeX;
+    header.m_size[1] = sizeY;
+    header.m_size[2] = sizeZ;
+    header.m_scale[0] = scaleX;
+    header.m_scale[1] = scaleY;
+    header.m_scale[2] = scaleZ;
+    header.m_offset[0] = offsetX;
+    header.m_offset[1] = offsetY;
+    header.m_offset[2] = offsetZ;
+    std::unique_lock<std::mutex> lock(rimpl.m_launch->m_mutex);
+    rimpl.m_launch->update(rimpl.m_context, rimpl.m_cmdQueue, header, &param, 1);
+    kernel.setArg(0, rimpl.m_launch->m_buffer);
+    kernel.setArg(1, buf_data);
+
+    //Execute task, samples stay on device
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize), cl::NullRange, &rimpl.m_launch->m_waits);
+    assert(err == CL_SUCCESS);
+    lock.unlock();
+    select_field(rimpl.m_kernels, rimpl.m_context, rimpl.m_cmdQueue, buf_data, msize, fractions, count, thresholds, mask);
+}
+
+//Worms
+void KernelAdapter::GEN_Worms3(
+    Snapshot param, Snapshot steer,                  // IN : class members of density and steering noise
+
+    size_t sizeX, size_t sizeY, size_t sizeZ,        // |
+    float scaleX, float scaleY, float scaleZ,        // | IN : Parameters
+    float offsetX, float offsetY, float offsetZ,     // |
+
+    float* starts, size_t worms,                     // IN : x, y, z and radius of every worm
+    size_t steps, float step, float turn,            // IN : path settings
+    float depth,                                     // IN : density removed at worm centre
+
+    float* result
+) {
+    //Configure stuff
+    cl_int err;
+    size_t msize = sizeX * sizeY * sizeZ;
+    cl_uint usteps = (cl_uint)steps;
+
+    //Get CL objects, 3D kernels are ordered like NoiseType
+    cl::Kernel kernel(rimpl.m_kernels[VALUE3 + param.m_noiseType]);
+    cl::Kernel worm(rimpl.m_kernels[WORMS3]);
+    cl::Kernel carve(rimpl.m_kernels[CARVE3]);
+    cl::Kernel apply(rimpl.m_kernels[CARVEAPPLY3]);
+
+    //Create buffers
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Execute task, density stays on device until carved
+    LaunchParams header = {};
+    header.m_size[0] = sizeX;
+    header.m_size[1] = sizeY;
+    header.m_size[2] = sizeZ;
+    header.m_scale[0] = scaleX;
+    header.m_scale[1] = scaleY;
+    header.m_scale[2] = scaleZ;
+    header.m_offset[0] = offsetX;
+    header.m_offset[1] = offsetY;
+    header.m_offset[2] = offsetZ;
+    std::unique_lock<std::mutex> lock(rimpl.m_launch->m_mutex);
+    rimpl.m_launch->update(rimpl.m_context, rimpl.m_cmdQueue, header, &param, 1);
+    kernel.setArg(0, rimpl.m_launch->m_buffer);
+    kernel.setArg(1, buf_result);
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(msize), cl::NullRange, &rimpl.m_launch->m_waits);
+    assert(err == CL_SUCCESS);
+    lock.unlock();
+
+    if (worms && steps) {
+        cl::Buffer buf_starts(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * 4 * worms, starts, &err);
+        assert(err == CL_SUCCESS);
+        cl::Buffer buf_path(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(float) * 4 * worms * (steps + 1), nullptr, &err);
+        assert(err == CL_SUCCESS);
+        cl::Buffer buf_carve(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(cl_int) * msize, nullptr, &err);
+        assert(err == CL_SUCCESS);
+        err = rimpl.m_cmdQueue.enqueueFillBuffer(buf_carve, (cl_int)0, 0, sizeof(cl_int) * msize);
+        assert(err == CL_SUCCESS);
+
+        //Prepare kernel
+        worm.setArg(0, sizeof(Snapshot), &steer);
+        worm.setArg(1, buf_starts);
+        worm.setArg(2, sizeof(cl_uint), &usteps);
+        worm.setArg(3, sizeof(float), &step);
+        worm.setArg(4, sizeof(float), &turn);
+        worm.setArg(5, buf_path);
+
+        carve.setArg(0, buf_path);
+        carve.setArg(1, sizeof(cl_uint), &usteps);
+        carve.setArg(2, sizeof(size_t), &sizeX);
+        carve.setArg(3, sizeof(size_t), &sizeY);
+        carve.setArg(4, sizeof(size_t), &sizeZ);
+        carve.setArg(5, sizeof(float), &scaleX);
+        carve.setArg(6, sizeof(float), &scaleY);
+        carve.setArg(7, sizeof(float), &scaleZ);
+        carve.setArg(8, sizeof(float), &offsetX);
+        carve.setArg(9, sizeof(float), &offsetY);
+        carve.setArg(10, sizeof(float), &offsetZ);
+        carve.setArg(11, buf_carve);
+
+        apply.setArg(0, buf_carve);
+        apply.setArg(1, sizeof(float), &depth);
+        apply.setArg(2, buf_result);
+
+        //Execute task, one work-item per worm, then per segment, then per sample
+        err = rimpl.m_cmdQueue.enqueueNDRangeKernel(worm, cl::NullRange, cl::NDRange(worms));
+        assert(err == CL_SUCCESS);
+        err = rimpl.m_cmdQueue.enqueueNDRangeKernel(carve, cl::NullRange, cl::NDRange(worms * steps));
+        assert(err == CL_SUCCESS);
+        err = rimpl.m_cmdQueue.enqueueNDRangeKernel(apply, cl::NullRange, cl::NDRange(msize));
+        assert(err == CL_SUCCESS);
+    }
+
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * msize, result);
+    assert(err == CL_SUCCESS);
+}
+
+//Async
+struct AsyncTask {
+    AsyncCallback done;
+    void* data;
+};
+void CL_CALLBACK async_complete(cl_event, cl_int status, void* data) {
+    AsyncTask* task = (AsyncTask*)data;
+    task->done(task->data, status == CL_COMPLETE);
+    delete task;
+}
+
+bool KernelAdapter::GEN_Async(
+    Snapshot* params, size_t size_p, bool lookup,
+    int dimensions,
+
+    size_t* sizes,
+    float* scales,
+    float* offsets,
+
+    float* result,
+    AsyncCallback done, void* data
+) {
+    //Get CL objects, typed kernels are ordered like NoiseType
+    int type = params[0].m_noiseType;
+    size_t index;
+    if (lookup) {
+        if (dimensions != 2 && dimensions != 3) return false;
+        index = dimensions == 2 ? LOOKUP_CELLULAR2 : LOOKUP_CELLULAR3;
+    } else switch (dimensions) {
+    case 1:
+        if (type > SIMPLEXFRACTAL1 - VALUE1) return false;
+        index = VALUE1 + type;
+        break;
+    case 2:
+        index = VALUE2 + type;
+        break;
+    case 3:
+        index = VALUE3 + type;
+        break;
+    case 4:
+        if (type == SIMPLEX2 - VALUE2) index = SIMPLEX4;
+        else if (type == WHITENOISE2 - VALUE2) index = WHITENOISE4;
+        else return false;
+        break;
+    default:
+        return false;
+    }
+    cl::Kernel kernel(rimpl.m_kernels[index]);
+
+    //Configure stuff
+    cl_int err;
+    LaunchParams header = {};
+    size_t total = 1;
+    for (int d = 0; d < dimensions; d++) {
+        header.m_size[d] = sizes[d];
+        header.m_scale[d] = scales[d];
+        header.m_offset[d] = offsets[d];
+        total *= sizes[d];
+    }
+    size_t msize = m_sliceCount ? m_sliceCount : total - m_sliceFirst;
+
+    //Create buffers, released by OpenCL once the read finished
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * msize, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel, launch block upload is not waited for here, kernel waits on it instead
+    std::unique_lock<std::mutex> lock(rimpl.m_launch->m_mutex);
+    rimpl.m_launch->update(rimpl.m_context, rimpl.m_cmdQueue, header, params, size_p);
+    kernel.setArg(0, rimpl.m_launch->m_buffer);
+    kernel.setArg(1, buf_result);
+
+    //Execute task, done is called from the completion callback of the read
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NDRange(m_sliceFirst), cl::NDRange(msize), cl::NullRange, &rimpl.m_launch->m_waits);
+    assert(err == CL_SUCCESS);
+    lock.unlock();
+
+    cl::Event event;
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_FALSE, 0, sizeof(float) * msize, result, nullptr, &event);
+    assert(err == CL_SUCCESS);
+    err = clSetEventCallback(event(), CL_COMPLETE, async_complete, new AsyncTask{ done, data });
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.flush();
+    assert(err == CL_SUCCESS);
+
+    return true;
+}
+
+//Brickmap
+#define BRICK_SIZE 8 // Same as BRICK_SIZE in Noise.cl
+
+void KernelAdapter::GEN_Brickmap3(
+    Snapshot param,                              // IN : class members
+
+    size_t sizeX, size_t sizeY, size_t sizeZ,    // |
+    float scaleX, float scaleY, float scaleZ,    // | IN : Parameters
+    float offsetX, float offsetY, float offsetZ, // |
+
+    float low, float high, float epsilon,
+
+    int* table,
+    std::vector<float>& pool
+) {
+    //Configure stuff
+    cl_int err;
+    size_t bricks = ((sizeX + BRICK_SIZE - 1) / BRICK_SIZE) * ((sizeY + BRICK_SIZE - 1) / BRICK_SIZE) * ((sizeZ + BRICK_SIZE - 1) / BRICK_SIZE);
+    LaunchParams header = {};
+    header.m_size[0] = sizeX;
+    header.m_size[1] = sizeY;
+    header.m_size[2] = sizeZ;
+    header.m_scale[0] = scaleX;
+    header.m_scale[1] = scaleY;
+    header.m_scale[2] = scaleZ;
+    header.m_offset[0] = offsetX;
+    header.m_offset[1] = offsetY;
+    header.m_offset[2] = offsetZ;
+
+    //Get CL objects
+    cl::Kernel classify(rimpl.m_kernels[BRICK_CLASSIFY]);
+    cl::Kernel fill(rimpl.m_kernels[BRICK_FILL]);
+
+    //Create buffers, no dense volume is ever stored
+    cl::Buffer buf_table(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(cl_int) * 2 * bricks, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Execute task, every brick is generated in local memory of its group and only classified
+    std::unique_lock<std::mutex> lock(rimpl.m_launch->m_mutex);
+    rimpl.m_launch->update(rimpl.m_context, rimpl.m_cmdQueue, header, &param, 1);
+    classify.setArg(0, rimpl.m_launch->m_buffer);
+    classify.setArg(1, sizeof(float), &low);
+    classify.setArg(2, sizeof(float), &high);
+    classify.setArg(3, sizeof(float), &epsilon);
+    classify.setArg(4, buf_table);
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(classify, cl::NullRange, cl::NDRange(bricks * BRICK_SIZE * BRICK_SIZE), cl::NDRange(BRICK_SIZE * BRICK_SIZE), &rimpl.m_launch->m_waits);
+    assert(err == CL_SUCCESS);
+    lock.unlock();
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_table, CL_TRUE, 0, sizeof(cl_int) * 2 * bricks, table);
+    assert(err == CL_SUCCESS);
+
+    //Assign pool entries in brick order
+    std::vector<cl_uint> entries;
+    for (size_t b = 0; b < bricks; b++) {
+        if (table[b * 2]) {
+            table[b * 2] = (int)entries.size();
+            entries.push_back((cl_uint)b);
+        } else table[b * 2] = -1;
+    }
+
+    pool.resize(entries.size() * BRICK_SIZE * BRICK_SIZE * BRICK_SIZE);
+    if (entries.empty()) return;
+
+    cl::Buffer buf_entries(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(cl_uint) * entries.size(), entries.data(), &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_pool(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * pool.size(), nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Only non-uniform bricks are generated again, straight into the pool
+    lock.lock();
+    rimpl.m_launch->update(rimpl.m_context, rimpl.m_cmdQueue, header, &param, 1);
+    fill.setArg(0, rimpl.m_launch->m_buffer);
+    fill.setArg(1, sizeof(float), &low);
+    fill.setArg(2, sizeof(float), &high);
+    fill.setArg(3, buf_entries);
+    fill.setArg(4, buf_pool);
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(fill, cl::NullRange, cl::NDRange(pool.size()), cl::NullRange, &rimpl.m_launch->m_waits);
+    assert(err == CL_SUCCESS);
+    lock.unlock();
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_pool, CL_TRUE, 0, sizeof(float) * pool.size(), pool.data());
+    assert(err == CL_SUCCESS);
+}
+
+//Chunk cache
+ChunkStore* KernelAdapter::CACHE_Create(size_t chunkSamples, size_t slots, size_t tableEntries) {
+    //Configure stuff
+    cl_int err;
+    ChunkStore* store = new ChunkStore;
+    store->m_chunkSamples = chunkSamples;
+    store->m_tableEntries = tableEntries;
+
+    //Create buffers, table starts empty
+    store->m_pool = cl::Buffer(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(float) * chunkSamples * slots, nullptr, &err);
+    assert(err == CL_SUCCESS);
+    store->m_table = cl::Buffer(rimpl.m_context, CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(cl_int) * 4 * tableEntries, nullptr, &err);
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueFillBuffer(store->m_table, (cl_int)-1, 0, sizeof(cl_int) * 4 * tableEntries);
+    assert(err == CL_SUCCESS);
+
+    return store;
+}
+void KernelAdapter::CACHE_Release(ChunkStore* store) {
+    delete store;
+}
+void KernelAdapter::CACHE_Table(ChunkStore* store, int* table) {
+    cl_int err = rimpl.m_cmdQueue.enqueueWriteBuffer(store->m_table, CL_TRUE, 0, sizeof(cl_int) * 4 * store->m_tableEntries, table);
+    assert(err == CL_SUCCESS);
+}
+void KernelAdapter::CACHE_Fill(
+    ChunkStore* store, Snapshot param,
+    int dimensions, size_t chunkSize, float step,
+
+    int* chunks, size_t count
+) {
+    //Configure stuff
+    cl_int err;
+    cl_uint size = (cl_uint)chunkSize;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[dimensions == 2 ? CACHE_FILL2 : CACHE_FILL3]);
+
+    //Create buffers
+    cl::Buffer buf_chunks(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(cl_int) * 4 * count, chunks, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, buf_chunks);
+    kernel.setArg(2, sizeof(cl_uint), &size);
+    kernel.setArg(3, sizeof(float), &step);
+    kernel.setArg(4, store->m_pool);
+
+    //Execute task, one work-item per sample of every chunk, pool stays on device
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(count * store->m_chunkSamples));
+    assert(err == CL_SUCCESS);
+}
+void KernelAdapter::CACHE_Gather(
+    ChunkStore* store, Snapshot param,
+    int dimensions, size_t chunkSize, float step,
+    float* points, size_t count,
+
+    float* result,
+    int* misses, size_t maxMisses,
+    size_t* missCount
+) {
+    //Configure stuff
+    cl_int err;
+    cl_uint size = (cl_uint)chunkSize;
+    cl_uint tableMask = (cl_uint)store->m_tableEntries - 1;
+    cl_uint maxQueued = (cl_uint)maxMisses;
+    size_t setEntries = 2;
+    while (setEntries < 2 * maxMisses) setEntries <<= 1;
+    cl_uint setMask = (cl_uint)setEntries - 1;
+
+    //Get CL objects
+    cl::Kernel kernel(rimpl.m_kernels[dimensions == 2 ? CACHE_GATHER2 : CACHE_GATHER3]);
+
+    //Create buffers, miss set and counter are zeroed on device
+    cl::Buffer buf_points(rimpl.m_context, CL_MEM_COPY_HOST_PTR | CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, sizeof(float) * dimensions * count, points, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_set(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(cl_uint) * setEntries, nullptr, &err);
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueFillBuffer(buf_set, (cl_uint)0, 0, sizeof(cl_uint) * setEntries);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_misses(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(cl_int) * 3 * std::max(maxMisses, (size_t)1), nullptr, &err);
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_count(rimpl.m_context, CL_MEM_READ_WRITE | CL_MEM_HOST_READ_ONLY, sizeof(cl_uint), nullptr, &err);
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueFillBuffer(buf_count, (cl_uint)0, 0, sizeof(cl_uint));
+    assert(err == CL_SUCCESS);
+    cl::Buffer buf_result(rimpl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, sizeof(float) * count, nullptr, &err);
+    assert(err == CL_SUCCESS);
+
+    //Prepare kernel
+    kernel.setArg(0, sizeof(Snapshot), &param);
+    kernel.setArg(1, store->m_table);
+    kernel.setArg(2, sizeof(cl_uint), &tableMask);
+    kernel.setArg(3, store->m_pool);
+    kernel.setArg(4, sizeof(cl_uint), &size);
+    kernel.setArg(5, sizeof(float), &step);
+    kernel.setArg(6, buf_points);
+    kernel.setArg(7, buf_set);
+    kernel.setArg(8, sizeof(cl_uint), &setMask);
+    kernel.setArg(9, buf_misses);
+    kernel.setArg(10, buf_count);
+    kernel.setArg(11, sizeof(cl_uint), &maxQueued);
+    kernel.setArg(12, buf_result);
+
+    //Execute task
+    err = rimpl.m_cmdQueue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(count));
+    assert(err == CL_SUCCESS);
+    err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_result, CL_TRUE, 0, sizeof(float) * count, result);
+    assert(err == CL_SUCCESS);
+
+    cl_uint queued = 0;
+    if (maxMisses) {
+        err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_count, CL_TRUE, 0, sizeof(cl_uint), &queued);
+        assert(err == CL_SUCCESS);
+        if (queued) {
+            err = rimpl.m_cmdQueue.enqueueReadBuffer(buf_misses, CL_TRUE, 0, sizeof(cl_int) * 3 * std::min((size_t)queued, maxMisses), misses);
+            assert(err == CL_SUCCESS);
+        }
+    }
+    if (missCount) *missCount = queued;
+}
@@ -26,6 +26,7 @@
 //
 
 #include <memory>
+#include <vector>
 
 #include "DeviceManager.h"
 
@@ -49,7 +50,7 @@ struct Snapshot {
     int m_cellularDistanceFunction;
     int m_cellularReturnType;
 
-    float m_perturbSeed;
+    int m_perturbSeed;
     float m_perturbAmp;
     int m_perturb;
     int m_perturbOctaves;
@@ -60,13 +61,78 @@ struct Snapshot {
     int m_perturbSmoothing;
 };
 
+//! \brief Device buffers of a chunk cache, only used through KernelAdapter
+class ChunkStore;
+//! \brief Called once an asynchronous result is written, from an OpenCL runtime thread
+typedef void (*AsyncCallback)(void* data, bool success);
+
 class KernelAdapter {
 public:
     //Initialize
     KernelAdapter(const Device& device);
     ~KernelAdapter();
 
+    //Slices
+    //! \brief Following 1D-4D and NoiseLookup kernels compute only samples [first, first + count) into result, count 0 computes all
+    void setSlice(size_t first, size_t count);
+
     //Kernels
+    //1D
+    void GEN_Value1(
+        Snapshot param, // IN : class members
+
+        size_t sizeX,   // |
+        float scaleX,   // | IN : Parameters
+        float offsetX,  // |
+
+        float* result
+    );
+    void GEN_ValueFractal1(
+        Snapshot param, // IN : class members
+
+        size_t sizeX,   // |
+        float scaleX,   // | IN : Parameters
+        float offsetX,  // |
+
+        float* result
+    );
+    void GEN_Perlin1(
+        Snapshot param, // IN : class members
+
+        size_t sizeX,   // |
+        float scaleX,   // | IN : Parameters
+        float offsetX,  // |
+
+        float* result
+    );
+    void GEN_PerlinFractal1(
+        Snapshot param, // IN : class members
+
+        size_t sizeX,   // |
+        float scaleX,   // | IN : Parameters
+        float offsetX,  // |
+
+        float* result
+    );
+    void GEN_Simplex1(
+        Snapshot param, // IN : class members
+
+        size_t sizeX,   // |
+        float scaleX,   // | IN : Parameters
+        float offsetX,  // |
+
+        float* result
+    );
+    void GEN_SimplexFractal1(
+        Snapshot param, // IN : class members
+
+        size_t sizeX,   // |
+        float scaleX,   // | IN : Parameters
+        float offsetX,  // |
+
+        float* result
+    );
+
     //2D
     void GEN_Value2(
         Snapshot param,               // IN : class members
@@ -256,7 +322,288 @@ public:
         float* result
     );
 
+    //Tiles
+    void GEN_Tiles2(
+        Snapshot param,               // IN : class members
+
+        float* tiles, size_t count,   // IN : offsetX, offsetY, scaleX, scaleY of every tile
+        size_t sizeX, size_t sizeY,   // IN : size of one tile
+
+        float* result
+    );
+
+    //Boxes
+    void GEN_Boxes3(
+        Snapshot param,               // IN : class members
+
+        float* origins,               // IN : originX, originY, originZ, step of every box
+        long long* boxes,             // IN : startX, startY, startZ, sizeX, sizeY, sizeZ of every box
+        size_t count,
+
+        float* result
+    );
+
+    //Biomes
+    void GEN_Biome2(
+        Snapshot* params, size_t size_p,                     // IN : members of every biome
+
+        unsigned char* biomes, size_t mapX, size_t mapY,     // |
+        size_t cell, float blend,                            // | IN : Biome map
+
+        size_t sizeX, size_t sizeY,                          // |
+        float scaleX, float scaleY,                          // | IN : Parameters
+        float offsetX, float offsetY,                        // |
+
+        float* result
+    );
+    void GEN_Biome3(
+        Snapshot* params, size_t size_p,                     // IN : members of every biome
+
+        unsigned char* biomes, size_t mapX, size_t mapY,     // |
+        size_t cell, float blend,                            // | IN : Biome map
+
+        size_t sizeX, size_t sizeY, size_t sizeZ,            // |
+        float scaleX, float scaleY, float scaleZ,            // | IN : Parameters
+        float offsetX, float offsetY, float offsetZ,         // |
+
+        float* result
+    );
+
+    //Octaves
+    void GEN_Octaves2(
+        Snapshot param,               // IN : class members
+        int first, int last,          // IN : octaves [first, last)
+
+        size_t sizeX, size_t sizeY,   // |
+        float scaleX, float scaleY,   // | IN : Parameters
+        float offsetX, float offsetY, // |
+
+        float* result                 // IN/OUT : values to add octaves to
+    );
+    void GEN_Octaves3(
+        Snapshot param,                              // IN : class members
+        int first, int last,                         // IN : octaves [first, last)
+
+        size_t sizeX, size_t sizeY, size_t sizeZ,    // |
+        float scaleX, float scaleY, float scaleZ,    // | IN : Parameters
+        float offsetX, float offsetY, float offsetZ, // |
+
+        float* result                                // IN/OUT : values to add octaves to
+    );
+
+    //Mesh
+    void GEN_Mesh3(
+        Snapshot param,                                       // IN : class members
+        float scale,                                          // IN : displacement per unit of noise
+
+        float* positions, float* normals, size_t vertexCount, // IN : 3 floats per vertex
+        unsigned int* indices, size_t faceCount,              // IN : 3 vertices per triangle
+        unsigned int* offsets, unsigned int* faces,           // IN : triangles of every vertex, offsets has vertexCount + 1 entries
+
+        float* resultPositions, float* resultNormals          // OUT : displaced mesh
+    );
+
+    //Points
+    void GEN_Points2(
+        Snapshot param,               // IN : class members
+        float* points, size_t count,  // IN : 2 floats per point
+
+        float* result
+    );
+    void GEN_Points3(
+        Snapshot param,               // IN : class members
+        float* points, size_t count,  // IN : 3 floats per point
+
+        float* result
+    );
+
+    //Approximate perturb
+    void GEN_PerturbApprox2(
+        Snapshot param,               // IN : class members
+        size_t factor,                // IN : samples per coarse cell along each axis
+
+        size_t sizeX, size_t sizeY,   // |
+        float scaleX, float scaleY,   // | IN : Parameters
+        float offsetX, float offsetY, // |
+
+        float* result
+    );
+    void GEN_PerturbApprox3(
+        Snapshot param,                              // IN : class members
+        size_t factor,                               // IN : samples per coarse cell along each axis
+
+        size_t sizeX, size_t sizeY, size_t sizeZ,    // |
+        float scaleX, float scaleY, float scaleZ,    // | IN : Parameters
+        float offsetX, float offsetY, float offsetZ, // |
+
+        float* result
+    );
+
+    //Levels
+    /*! \brief Refines level 0 into levels finer grids, each level is the coarse input of the next
+     * Level l has (size - 1) * 2^l + 1 samples with scale / 2^l, results[l - 1] receives it
+     */
+    void GEN_Levels2(
+        Snapshot param,               // IN : class members
+        float* coarse,                // IN : level 0
+
+        size_t sizeX, size_t sizeY,   // |
+        float scaleX, float scaleY,   // | IN : Parameters of level 0
+        float offsetX, float offsetY, // |
+
+        size_t levels, float** results // OUT : levels 1 to levels
+    );
+    void GEN_Levels3(
+        Snapshot param,                              // IN : class members
+        float* coarse,                               // IN : level 0
+
+        size_t sizeX, size_t sizeY, size_t sizeZ,    // |
+        float scaleX, float scaleY, float scaleZ,    // | IN : Parameters of level 0
+        float offsetX, float offsetY, float offsetZ, // |
+
+        size_t levels, float** results               // OUT : levels 1 to levels
+    );
+
+    //Axis grids
+    void GEN_Grid2(
+        Snapshot param,               // IN : class members
+
+        size_t sizeX, size_t sizeY,   // |
+        float* axes,                  // | IN : x coordinates followed by y coordinates
+
+        float* result
+    );
+    void GEN_Grid3(
+        Snapshot param,                           // IN : class members
+
+        size_t sizeX, size_t sizeY, size_t sizeZ, // |
+        float* axes,                              // | IN : x coordinates followed by y and z coordinates
+
+        float* result
+    );
+
+    //Block compression
+    void GEN_BC4(
+        Snapshot param,               // IN : class members
+
+        size_t sizeX, size_t sizeY,   // |
+        float scaleX, float scaleY,   // | IN : Parameters
+        float offsetX, float offsetY, // |
+
+        float low, float high,        // IN : range mapped to 0 - 255
+        int quality,                  // IN : endpoint candidates per block
+
+        unsigned char* result         // OUT : 8 bytes per block
+    );
+    void GEN_BC5(
+        Snapshot red, Snapshot green, // IN : class members of both channels
+
+        size_t sizeX, size_t sizeY,   // |
+        float scaleX, float scaleY,   // | IN : Parameters
+        float offsetX, float offsetY, // |
+
+        float low, float high,        // IN : range mapped to 0 - 255
+        int quality,                  // IN : endpoint candidates per block
+
+        unsigned char* result         // OUT : 16 bytes per block
+    );
+
+    //Selection
+    void SEL_Select2(
+        Snapshot param,                 // IN : class members
+
+        size_t sizeX, size_t sizeY,     // |
+        float scaleX, float scaleY,     // | IN : Parameters
+        float offsetX, float offsetY,   // |
+
+        float* fractions, size_t count, // IN : fractions of samples below selected values
+        float* thresholds,              // OUT : selected values
+        unsigned char* mask             // OUT : samples at or above first threshold, skipped if nullptr
+    );
+    void SEL_Select3(
+        Snapshot param,                              // IN : class members
+
+        size_t sizeX, size_t sizeY, size_t sizeZ,    // |
+        float scaleX, float scaleY, float scaleZ,    // | IN : Parameters
+        float offsetX, float offsetY, float offsetZ, // |
+
+        float* fractions, size_t count,              // IN : fractions of samples below selected values
+        float* thresholds,                           // OUT : selected values
+        unsigned char* mask                          // OUT : samples at or above first threshold, skipped if nullptr
+    );
+
+    //Worms
+    void GEN_Worms3(
+        Snapshot param, Snapshot steer,              // IN : class members of density and steering noise
+
+        size_t sizeX, size_t sizeY, size_t sizeZ,    // |
+        float scaleX, float scaleY, float scaleZ,    // | IN : Parameters
+        float offsetX, float offsetY, float offsetZ, // |
+
+        float* starts, size_t worms,                 // IN : x, y, z and radius of every worm
+        size_t steps, float step, float turn,        // IN : path settings
+        float depth,                                 // IN : density removed at worm centre
+
+        float* result
+    );
+
+    //Async
+    /*! \brief Starts the 1D-4D or NoiseLookup kernel like GEN_* without waiting, honours setSlice
+     * Returns false without calling done if the noise type has no kernel for dimensions
+     */
+    bool GEN_Async(
+        Snapshot* params, size_t size_p, bool lookup, // IN : class members, NoiseLookup chain if lookup
+        int dimensions,
+
+        size_t* sizes,                                // |
+        float* scales,                                // | IN : Parameters, dimensions each
+        float* offsets,                               // |
+
+        float* result,                                // OUT : must stay valid until done
+        AsyncCallback done, void* data
+    );
+
+    //Brickmap
+    void GEN_Brickmap3(
+        Snapshot param,                              // IN : class members
+
+        size_t sizeX, size_t sizeY, size_t sizeZ,    // |
+        float scaleX, float scaleY, float scaleZ,    // | IN : Parameters
+        float offsetX, float offsetY, float offsetZ, // |
+
+        float low, float high, float epsilon,        // IN : clamp range and largest distance to a uniform value
+
+        int* table,                                  // OUT : 2 per brick, pool entry or -1 followed by bits of uniform value
+        std::vector<float>& pool                     // OUT : samples of every pool entry
+    );
+
+    //Chunk cache
+    ChunkStore* CACHE_Create(size_t chunkSamples, size_t slots, size_t tableEntries);
+    void CACHE_Release(ChunkStore* store);
+    void CACHE_Table(
+        ChunkStore* store,
+        int* table                                   // IN : chunk x, y, z and slot per entry, slot -1 if free
+    );
+    void CACHE_Fill(
+        ChunkStore* store, Snapshot param,           // IN : class members
+        int dimensions, size_t chunkSize, float step,
+
+        int* chunks, size_t count                    // IN : chunk x, y, z and slot of every chunk to generate
+    );
+    void CACHE_Gather(
+        ChunkStore* store, Snapshot param,           // IN : class members, used on miss
+        int dimensions, size_t chunkSize, float step,
+        float* points, size_t count,                 // IN : dimensions floats per point
+
+        float* result,
+        int* misses, size_t maxMisses,               // OUT : x, y, z of every missed chunk, skipped if maxMisses is 0
+        size_t* missCount                            // OUT : number of missed chunks, may exceed maxMisses
+    );
+
 private:
+    size_t m_sliceFirst;
+    size_t m_sliceCount;
+
     class impl;
     impl& rimpl;
 
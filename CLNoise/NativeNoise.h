@@ -0,0 +1,536 @@
+// NativeNoise.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef NativeNoise_H
+#define NativeNoise_H
+
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <assert.h>
+#include <vector>
+#include <algorithm>
+#include "enums.h"
+#include "Noise.h"
+#include "Generator.h"
+#include "NoiseTables.h"
+
+//! \brief host versions of Noise.cl building blocks, used by NativeNoise
+namespace NativeDetail {
+
+#define X_PRIME 1619
+#define Y_PRIME 31337
+#define Z_PRIME 6971
+
+inline int FastFloor(float f) { return (int)std::floor(f); }
+inline float FastAbs(float f) { return std::fabs(f); }
+inline float Lerp(float a, float b, float t) { return a + t * (b - a); }
+
+// OpenCL integers wrap, so hashing is done on unsigned values
+inline int Wrap(unsigned int u) { int i; std::memcpy(&i, &u, sizeof(int)); return i; }
+inline int Cube60493(int n) { unsigned int u = (unsigned int)n; return Wrap(u * u * u * 60493u); }
+inline int Finish(int hash) { hash = Cube60493(hash); return (hash >> 13) ^ hash; }
+
+inline int Hash2D(int seed, int x, int y) { return Finish(seed ^ Wrap(X_PRIME * (unsigned int)x) ^ Wrap(Y_PRIME * (unsigned int)y)); }
+inline int Hash3D(int seed, int x, int y, int z) { return Finish(seed ^ Wrap(X_PRIME * (unsigned int)x) ^ Wrap(Y_PRIME * (unsigned int)y) ^ Wrap(Z_PRIME * (unsigned int)z)); }
+
+inline float ValCoord1D(int seed, int x) { return Cube60493(seed ^ Wrap(X_PRIME * (unsigned int)x)) / 2147483648.f; }
+inline float ValCoord2D(int seed, int x, int y) { return Cube60493(seed ^ Wrap(X_PRIME * (unsigned int)x) ^ Wrap(Y_PRIME * (unsigned int)y)) / 2147483648.f; }
+inline float ValCoord3D(int seed, int x, int y, int z) { return Cube60493(seed ^ Wrap(X_PRIME * (unsigned int)x) ^ Wrap(Y_PRIME * (unsigned int)y) ^ Wrap(Z_PRIME * (unsigned int)z)) / 2147483648.f; }
+
+inline float GradCoord1D(int seed, int x, float xd) {
+    return (Finish(seed ^ Wrap(X_PRIME * (unsigned int)x)) & 1) ? xd : -xd;
+}
+inline float GradCoord2D(int seed, int x, int y, float xd, float yd) {
+    int i = Hash2D(seed, x, y) & 7;
+    return xd * NoiseTables::GRAD_X[i] + yd * NoiseTables::GRAD_Y[i];
+}
+inline float GradCoord3D(int seed, int x, int y, int z, float xd, float yd, float zd) {
+    int i = Hash3D(seed, x, y, z) & 15;
+    return xd * NoiseTables::GRAD_X[i] + yd * NoiseTables::GRAD_Y[i] + zd * NoiseTables::GRAD_Z[i];
+}
+
+#undef X_PRIME
+#undef Y_PRIME
+#undef Z_PRIME
+
+// Smoothing
+template<Smoothing S> inline float Interp(float t);
+template<> inline float Interp<Smoothing::Linear>(float t) { return t; }
+template<> inline float Interp<Smoothing::Hermite>(float t) { return t * t * (3 - 2 * t); }
+template<> inline float Interp<Smoothing::Quintic>(float t) { return t * t * t * (t * (t * 6 - 15) + 10); }
+
+// Value
+template<Smoothing S> inline float SingleValue(int seed, float x) {
+    int x0 = FastFloor(x);
+    return Lerp(ValCoord1D(seed, x0), ValCoord1D(seed, x0 + 1), Interp<S>(x - x0));
+}
+template<Smoothing S> inline float SingleValue(int seed, float x, float y) {
+    int x0 = FastFloor(x), y0 = FastFloor(y);
+    float xs = Interp<S>(x - x0), ys = Interp<S>(y - y0);
+
+    float xf0 = Lerp(ValCoord2D(seed, x0, y0), ValCoord2D(seed, x0 + 1, y0), xs);
+    float xf1 = Lerp(ValCoord2D(seed, x0, y0 + 1), ValCoord2D(seed, x0 + 1, y0 + 1), xs);
+    return Lerp(xf0, xf1, ys);
+}
+template<Smoothing S> inline float SingleValue(int seed, float x, float y, float z) {
+    int x0 = FastFloor(x), y0 = FastFloor(y), z0 = FastFloor(z);
+    int x1 = x0 + 1, y1 = y0 + 1, z1 = z0 + 1;
+    float xs = Interp<S>(x - x0), ys = Interp<S>(y - y0), zs = Interp<S>(z - z0);
+
+    float xf00 = Lerp(ValCoord3D(seed, x0, y0, z0), ValCoord3D(seed, x1, y0, z0), xs);
+    float xf10 = Lerp(ValCoord3D(seed, x0, y1, z0), ValCoord3D(seed, x1, y1, z0), xs);
+    float xf01 = Lerp(ValCoord3D(seed, x0, y0, z1), ValCoord3D(seed, x1, y0, z1), xs);
+    float xf11 = Lerp(ValCoord3D(seed, x0, y1, z1), ValCoord3D(seed, x1, y1, z1), xs);
+    return Lerp(Lerp(xf00, xf10, ys), Lerp(xf01, xf11, ys), zs);
+}
+
+// Perlin
+template<Smoothing S> inline float SinglePerlin(int seed, float x) {
+    int x0 = FastFloor(x);
+    float xd0 = x - x0;
+    return 2 * Lerp(GradCoord1D(seed, x0, xd0), GradCoord1D(seed, x0 + 1, xd0 - 1), Interp<S>(xd0));
+}
+template<Smoothing S> inline float SinglePerlin(int seed, float x, float y) {
+    int x0 = FastFloor(x), y0 = FastFloor(y);
+    int x1 = x0 + 1, y1 = y0 + 1;
+    float xd0 = x - x0, yd0 = y - y0;
+    float xd1 = xd0 - 1, yd1 = yd0 - 1;
+    float xs = Interp<S>(xd0), ys = Interp<S>(yd0);
+
+    float xf0 = Lerp(GradCoord2D(seed, x0, y0, xd0, yd0), GradCoord2D(seed, x1, y0, xd1, yd0), xs);
+    float xf1 = Lerp(GradCoord2D(seed, x0, y1, xd0, yd1), GradCoord2D(seed, x1, y1, xd1, yd1), xs);
+    return Lerp(xf0, xf1, ys);
+}
+template<Smoothing S> inline float SinglePerlin(int seed, float x, float y, float z) {
+    int x0 = FastFloor(x), y0 = FastFloor(y), z0 = FastFloor(z);
+    int x1 = x0 + 1, y1 = y0 + 1, z1 = z0 + 1;
+    float xd0 = x - x0, yd0 = y - y0, zd0 = z - z0;
+    float xd1 = xd0 - 1, yd1 = yd0 - 1, zd1 = zd0 - 1;
+    float xs = Interp<S>(xd0), ys = Interp<S>(yd0), zs = Interp<S>(zd0);
+
+    float xf00 = Lerp(GradCoord3D(seed, x0, y0, z0, xd0, yd0, zd0), GradCoord3D(seed, x1, y0, z0, xd1, yd0, zd0), xs);
+    float xf10 = Lerp(GradCoord3D(seed, x0, y1, z0, xd0, yd1, zd0), GradCoord3D(seed, x1, y1, z0, xd1, yd1, zd0), xs);
+    float xf01 = Lerp(GradCoord3D(seed, x0, y0, z1, xd0, yd0, zd1), GradCoord3D(seed, x1, y0, z1, xd1, yd0, zd1), xs);
+    float xf11 = Lerp(GradCoord3D(seed, x0, y1, z1, xd0, yd1, zd1), GradCoord3D(seed, x1, y1, z1, xd1, yd1, zd1), xs);
+    return Lerp(Lerp(xf00, xf10, ys), Lerp(xf01, xf11, ys), zs);
+}
+
+// Simplex, smoothing is not used
+template<Smoothing S> inline float SingleSimplex(int seed, float x) {
+    int i = FastFloor(x);
+    float x0 = x - i, x1 = x0 - 1;
+
+    float t0 = 1 - x0 * x0;
+    t0 *= t0;
+    float t1 = 1 - x1 * x1;
+    t1 *= t1;
+    return 3.16f * (t0 * t0 * GradCoord1D(seed, i, x0) + t1 * t1 * GradCoord1D(seed, i + 1, x1));
+}
+template<Smoothing S> inline float SingleSimplex(int seed, float x, float y) {
+    const float F2 = 1.f / 2.f, G2 = 1.f / 4.f;
+
+    float t = (x + y) * F2;
+    int i = FastFloor(x + t);
+    int j = FastFloor(y + t);
+
+    t = (i + j) * G2;
+    float x0 = x - (i - t);
+    float y0 = y - (j - t);
+
+    int i1 = x0 > y0 ? 1 : 0;
+    int j1 = 1 - i1;
+
+    float x1 = x0 - i1 + G2, y1 = y0 - j1 + G2;
+    float x2 = x0 - 1 + F2, y2 = y0 - 1 + F2;
+
+    float n = 0;
+    t = 0.5f - x0 * x0 - y0 * y0;
+    if (t >= 0) { t *= t; n += t * t * GradCoord2D(seed, i, j, x0, y0); }
+    t = 0.5f - x1 * x1 - y1 * y1;
+    if (t >= 0) { t *= t; n += t * t * GradCoord2D(seed, i + i1, j + j1, x1, y1); }
+    t = 0.5f - x2 * x2 - y2 * y2;
+    if (t >= 0) { t *= t; n += t * t * GradCoord2D(seed, i + 1, j + 1, x2, y2); }
+
+    return 50 * n;
+}
+template<Smoothing S> inline float SingleSimplex(int seed, float x, float y, float z) {
+    const float F3 = 1.0f / 3.0f, G3 = 1.0f / 6.0f, G33 = 1.0f / 6.0f * 3 - 1;
+
+    float t = (x + y + z) * F3;
+    int i = FastFloor(x + t);
+    int j = FastFloor(y + t);
+    int k = FastFloor(z + t);
+
+    t = (i + j + k) * G3;
+    float x0 = x - (i - t);
+    float y0 = y - (j - t);
+    float z0 = z - (k - t);
+
+    int i1, j1, k1, i2, j2, k2;
+    if (x0 >= y0) {
+        if (y0 >= z0)      { i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+        else if (x0 >= z0) { i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1; }
+        else               { i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1; }
+    } else {
+        if (y0 < z0)       { i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1; }
+        else if (x0 < z0)  { i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1; }
+        else               { i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+    }
+
+    float x1 = x0 - i1 + G3, y1 = y0 - j1 + G3, z1 = z0 - k1 + G3;
+    float x2 = x0 - i2 + F3, y2 = y0 - j2 + F3, z2 = z0 - k2 + F3;
+    float x3 = x0 + G33, y3 = y0 + G33, z3 = z0 + G33;
+
+    float n = 0;
+    t = 0.6f - x0 * x0 - y0 * y0 - z0 * z0;
+    if (t >= 0) { t *= t; n += t * t * GradCoord3D(seed, i, j, k, x0, y0, z0); }
+    t = 0.6f - x1 * x1 - y1 * y1 - z1 * z1;
+    if (t >= 0) { t *= t; n += t * t * GradCoord3D(seed, i + i1, j + j1, k + k1, x1, y1, z1); }
+    t = 0.6f - x2 * x2 - y2 * y2 - z2 * z2;
+    if (t >= 0) { t *= t; n += t * t * GradCoord3D(seed, i + i2, j + j2, k + k2, x2, y2, z2); }
+    t = 0.6f - x3 * x3 - y3 * y3 - z3 * z3;
+    if (t >= 0) { t *= t; n += t * t * GradCoord3D(seed, i + 1, j + 1, k + 1, x3, y3, z3); }
+
+    return 32 * n;
+}
+
+// White noise, frequency and smoothing are not used
+inline int Bits(float f) { int i; std::memcpy(&i, &f, sizeof(int)); return i ^ (i >> 16); }
+template<Smoothing S> inline float SingleWhite(int seed, float x) { return ValCoord1D(seed, Bits(x)); }
+template<Smoothing S> inline float SingleWhite(int seed, float x, float y) { return ValCoord2D(seed, Bits(x), Bits(y)); }
+template<Smoothing S> inline float SingleWhite(int seed, float x, float y, float z) { return ValCoord3D(seed, Bits(x), Bits(y), Bits(z)); }
+
+// Single octave of a noise type
+template<NoiseType T, Smoothing S> struct Basis;
+#define NATIVE_BASIS(TYPE, FUNC) \
+    template<Smoothing S> struct Basis<NoiseType::TYPE, S> { \
+        static float get(int seed, float x) { return FUNC<S>(seed, x); } \
+        static float get(int seed, float x, float y) { return FUNC<S>(seed, x, y); } \
+        static float get(int seed, float x, float y, float z) { return FUNC<S>(seed, x, y, z); } \
+    };
+NATIVE_BASIS(Value, SingleValue)
+NATIVE_BASIS(ValueFractal, SingleValue)
+NATIVE_BASIS(Perlin, SinglePerlin)
+NATIVE_BASIS(PerlinFractal, SinglePerlin)
+NATIVE_BASIS(Simplex, SingleSimplex)
+NATIVE_BASIS(SimplexFractal, SingleSimplex)
+NATIVE_BASIS(WhiteNoise, SingleWhite)
+#undef NATIVE_BASIS
+
+// Octave combination, F and Octaves are constants so the loop unrolls without branches
+template<FractalType F> inline float Octave(float v);
+template<> inline float Octave<FractalType::FBM>(float v) { return v; }
+template<> inline float Octave<FractalType::Billow>(float v) { return FastAbs(v) * 2 - 1; }
+template<> inline float Octave<FractalType::RigidMulti>(float v) { return 1 - FastAbs(v); }
+
+template<class B, FractalType F, int Octaves> struct Fractal {
+    static float get(int seed, float lacunarity, float gain, float bounding, float x) {
+        float sum = Octave<F>(B::get(seed, x)), amp = 1;
+        for (int i = 1; i < Octaves; i++) {
+            x *= lacunarity;
+            amp *= gain;
+            sum += (F == FractalType::RigidMulti ? -amp : amp) * Octave<F>(B::get(++seed, x));
+        }
+        return F == FractalType::RigidMulti ? sum : sum * bounding;
+    }
+    static float get(int seed, float lacunarity, float gain, float bounding, float x, float y) {
+        float sum = Octave<F>(B::get(seed, x, y)), amp = 1;
+        for (int i = 1; i < Octaves; i++) {
+            x *= lacunarity;
+            y *= lacunarity;
+            amp *= gain;
+            sum += (F == FractalType::RigidMulti ? -amp : amp) * Octave<F>(B::get(++seed, x, y));
+        }
+        return F == FractalType::RigidMulti ? sum : sum * bounding;
+    }
+    static float get(int seed, float lacunarity, float gain, float bounding, float x, float y, float z) {
+        float sum = Octave<F>(B::get(seed, x, y, z)), amp = 1;
+        for (int i = 1; i < Octaves; i++) {
+            x *= lacunarity;
+            y *= lacunarity;
+            z *= lacunarity;
+            amp *= gain;
+            sum += (F == FractalType::RigidMulti ? -amp : amp) * Octave<F>(B::get(++seed, x, y, z));
+        }
+        return F == FractalType::RigidMulti ? sum : sum * bounding;
+    }
+};
+
+// Perturb
+template<Smoothing S> inline void SinglePerturb(int seed, float amp, float frequency, float& x, float& y) {
+    float xf = x * frequency, yf = y * frequency;
+    int x0 = FastFloor(xf), y0 = FastFloor(yf);
+    int x1 = x0 + 1, y1 = y0 + 1;
+    float xs = Interp<S>(xf - x0), ys = Interp<S>(yf - y0);
+
+    int i1 = Hash2D(seed, x0, y0) & 255, i2 = Hash2D(seed, x1, y0) & 255;
+    float lx0x = Lerp(NoiseTables::CELL_2D_X[i1], NoiseTables::CELL_2D_X[i2], xs);
+    float ly0x = Lerp(NoiseTables::CELL_2D_Y[i1], NoiseTables::CELL_2D_Y[i2], xs);
+
+    i1 = Hash2D(seed, x0, y1) & 255;
+    i2 = Hash2D(seed, x1, y1) & 255;
+    float lx1x = Lerp(NoiseTables::CELL_2D_X[i1], NoiseTables::CELL_2D_X[i2], xs);
+    float ly1x = Lerp(NoiseTables::CELL_2D_Y[i1], NoiseTables::CELL_2D_Y[i2], xs);
+
+    x += Lerp(lx0x, lx1x, ys) * amp;
+    y += Lerp(ly0x, ly1x, ys) * amp;
+}
+template<Smoothing S> inline void SinglePerturb(int seed, float amp, float frequency, float& x, float& y, float& z) {
+    using NoiseTables::CELL_3D_X;
+    using NoiseTables::CELL_3D_Y;
+    using NoiseTables::CELL_3D_Z;
+
+    float xf = x * frequency, yf = y * frequency, zf = z * frequency;
+    int x0 = FastFloor(xf), y0 = FastFloor(yf), z0 = FastFloor(zf);
+    int x1 = x0 + 1, y1 = y0 + 1, z1 = z0 + 1;
+    float xs = Interp<S>(xf - x0), ys = Interp<S>(yf - y0), zs = Interp<S>(zf - z0);
+
+    int i1 = Hash3D(seed, x0, y0, z0) & 255, i2 = Hash3D(seed, x1, y0, z0) & 255;
+    float lx0x = Lerp(CELL_3D_X[i1], CELL_3D_X[i2], xs);
+    float ly0x = Lerp(CELL_3D_Y[i1], CELL_3D_Y[i2], xs);
+    float lz0x = Lerp(CELL_3D_Z[i1], CELL_3D_Z[i2], xs);
+
+    i1 = Hash3D(seed, x0, y1, z0) & 255;
+    i2 = Hash3D(seed, x1, y1, z0) & 255;
+    float lx1x = Lerp(CELL_3D_X[i1], CELL_3D_X[i2], xs);
+    float ly1x = Lerp(CELL_3D_Y[i1], CELL_3D_Y[i2], xs);
+    float lz1x = Lerp(CELL_3D_Z[i1], CELL_3D_Z[i2], xs);
+
+    float lx0y = Lerp(lx0x, lx1x, ys);
+    float ly0y = Lerp(ly0x, ly1x, ys);
+    float lz0y = Lerp(lz0x, lz1x, ys);
+
+    i1 = Hash3D(seed, x0, y0, z1) & 255;
+    i2 = Hash3D(seed, x1, y0, z1) & 255;
+    lx0x = Lerp(CELL_3D_X[i1], CELL_3D_X[i2], xs);
+    ly0x = Lerp(CELL_3D_Y[i1], CELL_3D_Y[i2], xs);
+    lz0x = Lerp(CELL_3D_Z[i1], CELL_3D_Z[i2], xs);
+
+    i1 = Hash3D(seed, x0, y1, z1) & 255;
+    i2 = Hash3D(seed, x1, y1, z1) & 255;
+    lx1x = Lerp(CELL_3D_X[i1], CELL_3D_X[i2], xs);
+    ly1x = Lerp(CELL_3D_Y[i1], CELL_3D_Y[i2], xs);
+    lz1x = Lerp(CELL_3D_Z[i1], CELL_3D_Z[i2], xs);
+
+    x += Lerp(lx0y, Lerp(lx0x, lx1x, ys), zs) * amp;
+    y += Lerp(ly0y, Lerp(ly0x, ly1x, ys), zs) * amp;
+    z += Lerp(lz0y, Lerp(lz0x, lz1x, ys), zs) * amp;
+}
+
+inline float Bounding(int octaves, float gain) {
+    float amp = gain, ampFractal = 1.0f;
+    for (int i = 1; i < octaves; i++) {
+        ampFractal += amp;
+        amp *= gain;
+    }
+    return 1.0f / ampFractal;
+}
+
+inline bool IsFractal(NoiseType type) {
+    return type == NoiseType::ValueFractal || type == NoiseType::PerlinFractal || type == NoiseType::SimplexFractal;
+}
+
+}
+
+/*! \brief CPU evaluation of one fixed Noise configuration, same math as Noise.cl
+ * Everything that selects a code path is a template parameter, so evaluation has no
+ * dispatch and no configuration branches, and fill() loops are easy to vectorize.
+ * Supports Value, Perlin, Simplex, their fractals and WhiteNoise in 1D, 2D and 3D.
+ * Perturb is applied in 2D and 3D, like the kernels do. Cellular is not supported
+ */
+template<NoiseType Type, int Dimensions,
+         FractalType Fractal = FractalType::FBM, int Octaves = 1,
+         Smoothing Smooth = Smoothing::Quintic,
+         PerturbType PerturbMode = PerturbType::None, int PerturbOctaves = 1, Smoothing PerturbSmooth = Smoothing::Quintic>
+class NativeNoise {
+    static_assert(Type != NoiseType::Cellular, "Cellular noise has no native version");
+    static_assert(Dimensions >= 1 && Dimensions <= 3, "Native noise supports 1 to 3 dimensions");
+    static_assert(Octaves >= 1 && PerturbOctaves >= 1, "Octave count has to be positive");
+
+    typedef NativeDetail::Basis<Type, Smooth> B;
+    typedef NativeDetail::Fractal<B, Fractal, Octaves> F;
+
+public:
+    int seed = 1337;
+    float frequency = 0.01f;
+    float lacunarity = 2.0f;
+    float gain = 0.5f;
+
+    int perturbSeed = 1337;
+    float perturbAmp = 1.0f;
+    float perturbFrequency = 0.01f;
+    float perturbLacunarity = 2.0f;
+    float perturbGain = 0.5f;
+
+    //! \brief Create evaluator with default Noise values
+    NativeNoise() {
+        updateBounding();
+    }
+    /*! \brief Create evaluator with runtime values of noise
+     * Values selected by template parameters have to match noise
+     */
+    NativeNoise(const Noise& noise) {
+        assert(noise.getNoiseType() == Type);
+        seed = noise.getSeed();
+        frequency = noise.getFrequency();
+
+        if (NativeDetail::IsFractal(Type)) {
+            assert(noise.getFractalType() == Fractal && noise.getSmoothingFunction() == Smooth);
+            if (noise.getFractal()) {
+                assert(noise.getFractal()->getOctaves() == Octaves);
+                lacunarity = noise.getFractal()->getLacunarity();
+                gain = noise.getFractal()->getGain();
+            }
+        }
+
+        const Perturb* p = noise.getPerturb();
+        assert((p ? p->getPerturbType() : PerturbType::None) == PerturbMode);
+        if (p) {
+            perturbSeed = p->getSeed();
+            perturbAmp = p->getAmplitude();
+            perturbFrequency = p->getFrequency();
+            if (p->getFractal()) {
+                assert(PerturbMode != PerturbType::Fractal || p->getFractal()->getOctaves() == PerturbOctaves);
+                perturbLacunarity = p->getFractal()->getLacunarity();
+                perturbGain = p->getFractal()->getGain();
+            }
+        }
+
+        updateBounding();
+    }
+
+    //! \brief Recalculates fractal bounding, call after changing gain or perturbGain
+    void updateBounding() {
+        m_bounding = NativeDetail::Bounding(Octaves, gain);
+        m_perturbBounding = NativeDetail::Bounding(PerturbOctaves, perturbGain);
+    }
+
+    // Evaluation
+    float get(float x) const {
+        static_assert(Dimensions == 1, "Wrong coordinate count");
+        return evaluate(scale(x));
+    }
+    float get(float x, float y) const {
+        static_assert(Dimensions == 2, "Wrong coordinate count");
+        perturb(x, y);
+        return evaluate(scale(x), scale(y));
+    }
+    float get(float x, float y, float z) const {
+        static_assert(Dimensions == 3, "Wrong coordinate count");
+        perturb(x, y, z);
+        return evaluate(scale(x), scale(y), scale(z));
+    }
+
+    // Ranges, results use the layout of Generator::getNoise
+    void fill(const Range& x, float* out) const {
+        for (size_t i = 0; i < x.size; i++)
+            out[i] = get(i * x.step + x.offset);
+    }
+    void fill(const Range& x, const Range& y, float* out) const {
+        for (size_t i = 0; i < x.size; i++) {
+            float xc = i * x.step + x.offset;
+            float* row = out + i * y.size;
+            for (size_t j = 0; j < y.size; j++)
+                row[j] = get(xc, j * y.step + y.offset);
+        }
+    }
+    void fill(const Range& x, const Range& y, const Range& z, float* out) const {
+        for (size_t k = 0; k < z.size; k++) {
+            float zc = k * z.step + z.offset;
+            for (size_t i = 0; i < x.size; i++) {
+                float xc = i * x.step + x.offset;
+                float* row = out + (k * x.size + i) * y.size;
+                for (size_t j = 0; j < y.size; j++)
+                    row[j] = get(xc, j * y.step + y.offset, zc);
+            }
+        }
+    }
+
+    // Verification
+    /*! \brief Returns largest difference to the kernel result for the same ranges
+     * Noise set on generator has to match this evaluator. Results agree up to float
+     * rounding of the device, e.g. fused multiply-add
+     */
+    float compare(Generator& generator, const Range& x) const {
+        NoiseBuffer b = generator.getNoise(x);
+        return difference(b, [&](float* out) { fill(x, out); });
+    }
+    float compare(Generator& generator, const Range& x, const Range& y) const {
+        NoiseBuffer b = generator.getNoise(x, y);
+        return difference(b, [&](float* out) { fill(x, y, out); });
+    }
+    float compare(Generator& generator, const Range& x, const Range& y, const Range& z) const {
+        NoiseBuffer b = generator.getNoise(x, y, z);
+        return difference(b, [&](float* out) { fill(x, y, z, out); });
+    }
+
+private:
+    float m_bounding;
+    float m_perturbBounding;
+
+    // WhiteNoise hashes raw coordinates
+    float scale(float c) const {
+        return Type == NoiseType::WhiteNoise ? c : c * frequency;
+    }
+    template<typename... C> float evaluate(C... c) const {
+        if (NativeDetail::IsFractal(Type)) return F::get(seed, lacunarity, gain, m_bounding, c...);
+        return B::get(seed, c...);
+    }
+
+    template<typename G> float difference(const NoiseBuffer& b, G generate) const {
+        if (!b.size) return INFINITY;
+
+        std::vector<float> native(b.size);
+        generate(native.data());
+
+        float diff = 0;
+        for (size_t i = 0; i < b.size; i++)
+            diff = std::max(diff, NativeDetail::FastAbs(native[i] - b.data[i]));
+        return diff;
+    }
+
+    template<typename... C> void perturb(C&... c) const {
+        if (PerturbMode == PerturbType::None) return;
+        if (PerturbMode == PerturbType::Single) {
+            NativeDetail::SinglePerturb<PerturbSmooth>(perturbSeed, perturbAmp, perturbFrequency, c...);
+            return;
+        }
+
+        int s = perturbSeed;
+        float amp = perturbAmp * m_perturbBounding;
+        float freq = perturbFrequency;
+        NativeDetail::SinglePerturb<PerturbSmooth>(s, amp, freq, c...);
+        for (int i = 1; i < PerturbOctaves; i++) {
+            freq *= perturbLacunarity;
+            amp *= perturbGain;
+            NativeDetail::SinglePerturb<PerturbSmooth>(++s, amp, freq, c...);
+        }
+    }
+};
+
+#endif
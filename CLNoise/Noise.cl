@@ -239,6 +239,13 @@ int Hash4D(int seed, int x, int y, int z, int w)
     return hash;
 }
 
+float ValCoord1D(int seed, int x)
+{
+	int n = seed;
+	n ^= X_PRIME * x;
+
+	return (n * n * n * 60493) / 2147483648.f;
+}
 float ValCoord2D(int seed, int x, int y)
 {
 	int n = seed;
@@ -267,6 +274,17 @@ float ValCoord4D(int seed, int x, int y, int z, int w)
 	return (n * n * n * 60493) / 2147483648.f;
 }
 
+float GradCoord1D(int seed, int x, float xd)
+{
+    int hash = seed;
+    hash ^= X_PRIME * x;
+
+    hash = hash * hash * hash * 60493;
+    hash = (hash >> 13) ^ hash;
+
+    return (hash & 1) ? xd : -xd;
+}
+
 float GradCoord2D(int seed, int x, int y, float xd, float yd)
 {
     int hash = seed;
@@ -603,6 +621,116 @@ float GetValue2(float m_frequency,
 	return SingleValue2(m_smoothing, m_seed, x * m_frequency, y * m_frequency);
 }
 
+//1D
+float SingleValue1(int m_smoothing,
+    int seed,
+    float x)
+{
+    int x0 = FastFloor(x);
+    int x1 = x0 + 1;
+
+    float xs;
+    switch (m_smoothing)
+    {
+        default:
+        case 0:
+            xs = x - x0;
+            break;
+        case 1:
+            xs = InterpHermiteFunc(x - x0);
+            break;
+        case 2:
+            xs = InterpQuinticFunc(x - x0);
+            break;
+    }
+
+    return Lerp(ValCoord1D(seed, x0), ValCoord1D(seed, x1), xs);
+}
+
+float SingleValueFractalFBM1(float m_lacunarity, float m_gain, int m_octaves, float m_fractalBounding,
+    int m_smoothing,
+    int seed,
+    float x)
+{
+    float sum = SingleValue1(m_smoothing, seed, x);
+    float amp = 1;
+
+    for (int i = 1; i < m_octaves; i++)
+    {
+        x *= m_lacunarity;
+
+        amp *= m_gain;
+        sum += SingleValue1(m_smoothing, ++seed, x) * amp;
+    }
+
+    return sum * m_fractalBounding;
+}
+float SingleValueFractalBillow1(float m_lacunarity, float m_gain, int m_octaves, float m_fractalBounding,
+    int m_smoothing,
+    int seed,
+    float x)
+{
+    float sum = FastAbs(SingleValue1(m_smoothing, seed, x)) * 2 - 1;
+    float amp = 1;
+
+    for (int i = 1; i < m_octaves; i++)
+    {
+        x *= m_lacunarity;
+
+        amp *= m_gain;
+        sum += (FastAbs(SingleValue1(m_smoothing, ++seed, x)) * 2 - 1) * amp;
+    }
+
+    return sum * m_fractalBounding;
+}
+float SingleValueFractalRigidMulti1(float m_lacunarity, float m_gain, int m_octaves,
+    int m_smoothing,
+    int seed,
+    float x)
+{
+    float sum = 1 - FastAbs(SingleValue1(m_smoothing, seed, x));
+    float amp = 1;
+
+    for (int i = 1; i < m_octaves; i++)
+    {
+        x *= m_lacunarity;
+
+        amp *= m_gain;
+        sum -= (1 - FastAbs(SingleValue1(m_smoothing, ++seed, x))) * amp;
+    }
+
+    return sum;
+}
+
+float GetValueFractal1(float m_frequency, int m_fractalType,
+    float m_lacunarity, float m_gain, int m_octaves, float m_fractalBounding,
+    int m_smoothing,
+    int m_seed,
+    float x)
+{
+	x *= m_frequency;
+
+	switch (m_fractalType)
+	{
+	case 0:
+		return SingleValueFractalFBM1(m_lacunarity, m_gain, m_octaves, m_fractalBounding, m_smoothing, m_seed, x);
+	case 1:
+		return SingleValueFractalBillow1(m_lacunarity, m_gain, m_octaves, m_fractalBounding, m_smoothing, m_seed, x);
+	case 2:
+		return SingleValueFractalRigidMulti1(m_lacunarity, m_gain, m_octaves, m_smoothing, m_seed, x);
+	default:
+		return 0.0f;
+	}
+}
+
+float GetValue1(float m_frequency,
+    int m_smoothing,
+    int m_seed,
+    float x)
+{
+	return SingleValue1(m_smoothing, m_seed, x * m_frequency);
+}
+
 
 //Perlin Noise
 //3D
@@ -879,6 +1007,120 @@ float GetPerlin2(float m_frequency,
 	return SinglePerlin2(m_smoothing, m_seed, x * m_frequency, y * m_frequency);
 }
 
+//1D
+float SinglePerlin1(int m_smoothing,
+    int seed,
+    float x)
+{
+    int x0 = FastFloor(x);
+    int x1 = x0 + 1;
+
+    float xs;
+    switch (m_smoothing)
+    {
+        default:
+        case 0:
+            xs = x - x0;
+            break;
+        case 1:
+            xs = InterpHermiteFunc(x - x0);
+            break;
+        case 2:
+            xs = InterpQuinticFunc(x - x0);
+            break;
+    }
+
+    float xd0 = x - x0;
+    float xd1 = xd0 - 1;
+
+    // Gradients are +-1, scaled to reach -1..1
+    return 2 * Lerp(GradCoord1D(seed, x0, xd0), GradCoord1D(seed, x1, xd1), xs);
+}
+
+float SinglePerlinFractalFBM1(int m_octaves, float m_lacunarity, float m_gain, float m_fractalBounding,
+    int m_smoothing,
+    int seed,
+    float x)
+{
+    float sum = SinglePerlin1(m_smoothing, seed, x);
+    float amp = 1;
+
+    for (int i = 1; i < m_octaves; i++)
+    {
+        x *= m_lacunarity;
+
+        amp *= m_gain;
+        sum += SinglePerlin1(m_smoothing, ++seed, x) * amp;
+    }
+
+    return sum * m_fractalBounding;
+}
+float SinglePerlinFractalBillow1(int m_octaves, float m_lacunarity, float m_gain, float m_fractalBounding,
+    int m_smoothing,
+    int seed,
+    float x)
+{
+    float sum = FastAbs(SinglePerlin1(m_smoothing, seed, x)) * 2 - 1;
+    float amp = 1;
+
+    for (int i = 1; i < m_octaves; i++)
+    {
+        x *= m_lacunarity;
+
+        amp *= m_gain;
+        sum += (FastAbs(SinglePerlin1(m_smoothing, ++seed, x)) * 2 - 1) * amp;
+    }
+
+    return sum * m_fractalBounding;
+}
+float SinglePerlinFractalRigidMulti1(int m_octaves, float m_lacunarity, float m_gain,
+    int m_smoothing,
+    int seed,
+    float x)
+{
+    float sum = 1 - FastAbs(SinglePerlin1(m_smoothing, seed, x));
+    float amp = 1;
+
+    for (int i = 1; i < m_octaves; i++)
+    {
+        x *= m_lacunarity;
+
+        amp *= m_gain;
+        sum -= (1 - FastAbs(SinglePerlin1(m_smoothing, ++seed, x))) * amp;
+    }
+
+    return sum;
+}
+
+float GetPerlinFractal1(float m_frequency, int m_fractalType,
+    int m_octaves, float m_lacunarity, float m_gain, float m_fractalBounding,
+    int m_smoothing,
+    int m_seed,
+    float x)
+{
+	x *= m_frequency;
+
+	switch (m_fractalType)
+	{
+	case 0:
+		return SinglePerlinFractalFBM1(m_octaves, m_lacunarity, m_gain, m_fractalBounding, m_smoothing, m_seed, x);
+	case 1:
+		return SinglePerlinFractalBillow1(m_octaves, m_lacunarity, m_gain, m_fractalBounding, m_smoothing, m_seed, x);
+	case 2:
+		return SinglePerlinFractalRigidMulti1(m_octaves, m_lacunarity, m_gain, m_smoothing, m_seed, x);
+	default:
+		return 0.0f;
+	}
+}
+
+float GetPerlin1(float m_frequency,
+    int m_smoothing,
+    int m_seed,
+    float x)
+{
+	return SinglePerlin1(m_smoothing, m_seed, x * m_frequency);
+}
+
 
 //Simplex Noise
 //3D
@@ -1216,6 +1458,104 @@ float GetSimplex2(float m_frequency,
 	return SingleSimplex2(m_seed, x * m_frequency, y * m_frequency);
 }
 
+//1D
+float SingleSimplex1(int seed,
+    float x)
+{
+    int i = FastFloor(x);
+    float x0 = x - i;
+    float x1 = x0 - 1;
+
+    float t = 1 - x0 * x0;
+    t *= t;
+    float n0 = t * t * GradCoord1D(seed, i, x0);
+
+    t = 1 - x1 * x1;
+    t *= t;
+    float n1 = t * t * GradCoord1D(seed, i + 1, x1);
+
+    return 3.16f * (n0 + n1);
+}
+
+float SingleSimplexFractalFBM1(int m_octaves, float m_lacunarity, float m_gain, float m_fractalBounding,
+    int seed,
+    float x)
+{
+    float sum = SingleSimplex1(seed, x);
+    float amp = 1;
+
+    for (int i = 1; i < m_octaves; i++)
+    {
+        x *= m_lacunarity;
+
+        amp *= m_gain;
+        sum += SingleSimplex1(++seed, x) * amp;
+    }
+
+    return sum * m_fractalBounding;
+}
+float SingleSimplexFractalBillow1(int m_octaves, float m_lacunarity, float m_gain, float m_fractalBounding,
+    int seed,
+    float x)
+{
+    float sum = FastAbs(SingleSimplex1(seed, x)) * 2 - 1;
+    float amp = 1;
+
+    for (int i = 1; i < m_octaves; i++)
+    {
+        x *= m_lacunarity;
+
+        amp *= m_gain;
+        sum += (FastAbs(SingleSimplex1(++seed, x)) * 2 - 1) * amp;
+    }
+
+    return sum * m_fractalBounding;
+}
+float SingleSimplexFractalRigidMulti1(int m_octaves, float m_lacunarity, float m_gain,
+    int seed,
+    float x)
+{
+    float sum = 1 - FastAbs(SingleSimplex1(seed, x));
+    float amp = 1;
+
+    for (int i = 1; i < m_octaves; i++)
+    {
+        x *= m_lacunarity;
+
+        amp *= m_gain;
+        sum -= (1 - FastAbs(SingleSimplex1(++seed, x))) * amp;
+    }
+
+    return sum;
+}
+
+float GetSimplexFractal1(float m_frequency, int m_fractalType,
+    int m_octaves, float m_lacunarity, float m_gain, float m_fractalBounding,
+    int m_seed,
+    float x)
+{
+	x *= m_frequency;
+
+	switch (m_fractalType)
+	{
+	case 0:
+		return SingleSimplexFractalFBM1(m_octaves, m_lacunarity, m_gain, m_fractalBounding, m_seed, x);
+	case 1:
+		return SingleSimplexFractalBillow1(m_octaves, m_lacunarity, m_gain, m_fractalBounding, m_seed, x);
+	case 2:
+		return SingleSimplexFractalRigidMulti1(m_octaves, m_lacunarity, m_gain, m_seed, x);
+	default:
+		return 0.0f;
+	}
+}
+
+float GetSimplex1(float m_frequency,
+    int m_seed,
+    float x)
+{
+	return SingleSimplex1(m_seed, x * m_frequency);
+}
+
 //4D
 __constant unsigned char SIMPLEX_4D[] =
 {
@@ -1964,7 +2304,7 @@ typedef struct {
     int m_cellularDistanceFunction;
     int m_cellularReturnType;
 
-    float m_perturbSeed;
+    int m_perturbSeed;
     float m_perturbAmp;
     int m_perturb;
     int m_perturbOctaves;
@@ -1975,13 +2315,28 @@ typedef struct {
     int m_perturbSmoothing;
 } Snapshot;
 
-void calculate_coord2(
-    size_t index,
-    size_t size_x, size_t size_y, float scale_x, float scale_y, float offset_x, float offset_y,
+/*
+ * Launch parameters, persistent __constant blocks per device rewritten only when they change
+ *   Header is followed by m_count Snapshots, the first is the noise itself and the rest its lookup chain
+ */
+typedef struct {
+    ulong m_size[4];    // |
+    float m_scale[4];   // | Ranges, unused axes are left zero
+    float m_offset[4];  // |
+
+    uint m_count;       // Snapshots following the header
+    uint m_padding;     // Keeps the chain 8 byte aligned
+} LaunchParams;
+
+#define launch_chain(launch) ((__constant Snapshot*)((launch) + 1))
+
+void calculate_coord2(
+    size_t index,
+    size_t size_x, size_t size_y, float scale_x, float scale_y, float offset_x, float offset_y,
     float* x, float* y
 ) {
-    size_t i = index / size_x;
-    size_t j = index - i * size_x;
+    size_t i = index / size_y;
+    size_t j = index - i * size_y;
 
     *x = i * scale_x + offset_x;
     *y = j * scale_y  + offset_y;
@@ -1992,8 +2347,8 @@ void calculate_coord3(
     float* x, float* y, float* z
 ) {
     size_t k = index / (size_x * size_y);
-    size_t i = (index - k * size_x * size_y) / size_x;
-    size_t j = index - k * size_x * size_y - i * size_x;
+    size_t i = (index - k * size_x * size_y) / size_y;
+    size_t j = index - k * size_x * size_y - i * size_y;
 
     *x = i * scale_x + offset_x;
     *y = j * scale_y  + offset_y;
@@ -2006,8 +2361,8 @@ void calculate_coord4(
 ) {
     size_t u = index / (size_x * size_y * size_z);
     size_t k = (index - u * size_x * size_y * size_z) / (size_y * size_x);
-    size_t i = (index - u * size_x * size_y * size_z - k * size_y * size_x) / size_x;
-    size_t j = index - u * size_x * size_y * size_z - k * size_y * size_x - i * size_x;
+    size_t i = (index - u * size_x * size_y * size_z - k * size_y * size_x) / size_y;
+    size_t j = index - u * size_x * size_y * size_z - k * size_y * size_x - i * size_y;
 
     *x = i * scale_x + offset_x;
     *y = j * scale_y  + offset_y;
@@ -2018,7 +2373,7 @@ void calculate_coord4(
 void apply_perturb2(Snapshot* param, float* x, float* y) {
     switch(param->m_perturb) {
     case 1:
-        Perturb2(param->m_perturbAmp, param->m_perturbFrequency, param->m_perturbSmoothing, param->m_perturbGain, x, y);
+        Perturb2(param->m_perturbAmp, param->m_perturbFrequency, param->m_perturbSmoothing, param->m_perturbSeed, x, y);
         break;
     case 2:
         PerturbFractal2(param->m_perturbAmp, param->m_perturbBounding, param->m_perturbFrequency, param->m_perturbOctaves, param->m_perturbLacunarity, param->m_perturbGain, param->m_perturbSmoothing, param->m_perturbSeed, x, y);
@@ -2030,7 +2385,7 @@ void apply_perturb2(Snapshot* param, float* x, float* y) {
 void apply_perturb3(Snapshot* param, float* x, float* y, float* z) {
     switch(param->m_perturb) {
     case 1:
-        Perturb3(param->m_perturbAmp, param->m_perturbFrequency, param->m_perturbSmoothing, param->m_perturbGain, x, y, z);
+        Perturb3(param->m_perturbAmp, param->m_perturbFrequency, param->m_perturbSmoothing, param->m_perturbSeed, x, y, z);
         break;
     case 2:
         PerturbFractal3(param->m_perturbAmp, param->m_perturbBounding, param->m_perturbFrequency, param->m_perturbOctaves, param->m_perturbLacunarity, param->m_perturbGain, param->m_perturbSmoothing, param->m_perturbSeed, x, y, z);
@@ -2040,17 +2395,166 @@ void apply_perturb3(Snapshot* param, float* x, float* y, float* z) {
     }
 }
 
+float GetNoise2(Snapshot* param, float x, float y) {
+    apply_perturb2(param, &x, &y);
+
+    switch(param->m_noiseType) {
+    case 0:
+        return GetValue2(param->m_frequency, param->m_smoothing, param->m_seed, x, y);
+    case 1:
+        return GetValueFractal2(param->m_fractalType, param->m_frequency, param->m_lacunarity, param->m_gain, param->m_octaves, param->m_fractalBounding, param->m_smoothing, param->m_seed, x, y);
+    case 2:
+        return GetPerlin2(param->m_frequency, param->m_smoothing, param->m_seed, x, y);
+    case 3:
+        return GetPerlinFractal2(param->m_frequency, param->m_fractalType, param->m_octaves, param->m_lacunarity, param->m_gain, param->m_fractalBounding, param->m_smoothing, param->m_seed, x, y);
+    case 4:
+        return GetSimplex2(param->m_frequency, param->m_seed, x, y);
+    case 5:
+        return GetSimplexFractal2(param->m_frequency, param->m_fractalType, param->m_octaves, param->m_lacunarity, param->m_gain, param->m_fractalBounding, param->m_seed, x, y);
+    case 6:
+        return GetCellular2(param->m_frequency, param->m_cellularDistanceFunction, param->m_cellularReturnType, param->m_cellularJitter, param->m_cellularDistanceIndex0, param->m_cellularDistanceIndex1, param->m_seed, x, y);
+    case 7:
+        return GetWhiteNoise2(param->m_seed, x, y);
+    default:
+        return 0.0f;
+    }
+}
+float GetNoise3(Snapshot* param, float x, float y, float z) {
+    apply_perturb3(param, &x, &y, &z);
+
+    switch(param->m_noiseType) {
+    case 0:
+        return GetValue3(param->m_frequency, param->m_smoothing, param->m_seed, x, y, z);
+    case 1:
+        return GetValueFractal3(param->m_frequency, param->m_fractalType, param->m_lacunarity, param->m_gain, param->m_octaves, param->m_fractalBounding, param->m_smoothing, param->m_seed, x, y, z);
+    case 2:
+        return GetPerlin3(param->m_frequency, param->m_smoothing, param->m_seed, x, y, z);
+    case 3:
+        return GetPerlinFractal3(param->m_frequency, param->m_fractalType, param->m_octaves, param->m_lacunarity, param->m_gain, param->m_fractalBounding, param->m_smoothing, param->m_seed, x, y, z);
+    case 4:
+        return GetSimplex3(param->m_frequency, param->m_seed, x, y, z);
+    case 5:
+        return GetSimplexFractal3(param->m_frequency, param->m_fractalType, param->m_octaves, param->m_lacunarity, param->m_gain, param->m_fractalBounding, param->m_seed, x, y, z);
+    case 6:
+        return GetCellular3(param->m_frequency, param->m_cellularDistanceFunction, param->m_cellularReturnType, param->m_cellularJitter, param->m_cellularDistanceIndex0, param->m_cellularDistanceIndex1, param->m_seed, x, y, z);
+    case 7:
+        return GetWhiteNoise3(param->m_seed, x, y, z);
+    default:
+        return 0.0f;
+    }
+}
+
+//1D
+__kernel void GEN_Value1(
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
+
+    __global float* noise)           // OUT : Noise array
+{
+    Snapshot param = launch_chain(launch)[0];
+    float scale_x = launch->m_scale[0];
+    float offset_x = launch->m_offset[0];
+
+    size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
+    float x = index * scale_x + offset_x; // Calculate coordinate
+
+    //Calculate value
+    noise[index] = GetValue1(param.m_frequency, param.m_smoothing, param.m_seed, x);
+}
+__kernel void GEN_ValueFractal1(
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
+
+    __global float* noise)           // OUT : Noise array
+{
+    Snapshot param = launch_chain(launch)[0];
+    float scale_x = launch->m_scale[0];
+    float offset_x = launch->m_offset[0];
+
+    size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
+    float x = index * scale_x + offset_x; // Calculate coordinate
+
+    //Calculate value
+    noise[index] = GetValueFractal1(param.m_frequency, param.m_fractalType, param.m_lacunarity, param.m_gain, param.m_octaves, param.m_fractalBounding, param.m_smoothing, param.m_seed, x);
+}
+__kernel void GEN_Perlin1(
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
+
+    __global float* noise)           // OUT : Noise array
+{
+    Snapshot param = launch_chain(launch)[0];
+    float scale_x = launch->m_scale[0];
+    float offset_x = launch->m_offset[0];
+
+    size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
+    float x = index * scale_x + offset_x; // Calculate coordinate
+
+    //Calculate value
+    noise[index] = GetPerlin1(param.m_frequency, param.m_smoothing, param.m_seed, x);
+}
+__kernel void GEN_PerlinFractal1(
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
+
+    __global float* noise)           // OUT : Noise array
+{
+    Snapshot param = launch_chain(launch)[0];
+    float scale_x = launch->m_scale[0];
+    float offset_x = launch->m_offset[0];
+
+    size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
+    float x = index * scale_x + offset_x; // Calculate coordinate
+
+    //Calculate value
+    noise[index] = GetPerlinFractal1(param.m_frequency, param.m_fractalType, param.m_octaves, param.m_lacunarity, param.m_gain, param.m_fractalBounding, param.m_smoothing, param.m_seed, x);
+}
+__kernel void GEN_Simplex1(
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
+
+    __global float* noise)           // OUT : Noise array
+{
+    Snapshot param = launch_chain(launch)[0];
+    float scale_x = launch->m_scale[0];
+    float offset_x = launch->m_offset[0];
+
+    size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
+    float x = index * scale_x + offset_x; // Calculate coordinate
+
+    //Calculate value
+    noise[index] = GetSimplex1(param.m_frequency, param.m_seed, x);
+}
+__kernel void GEN_SimplexFractal1(
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
+
+    __global float* noise)           // OUT : Noise array
+{
+    Snapshot param = launch_chain(launch)[0];
+    float scale_x = launch->m_scale[0];
+    float offset_x = launch->m_offset[0];
+
+    size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
+    float x = index * scale_x + offset_x; // Calculate coordinate
+
+    //Calculate value
+    noise[index] = GetSimplexFractal1(param.m_frequency, param.m_fractalType, param.m_octaves, param.m_lacunarity, param.m_gain, param.m_fractalBounding, param.m_seed, x);
+}
+
 //2D
 __kernel void GEN_Value2(
-    Snapshot param,                 // IN : class members
-
-    ulong size_x, ulong size_y,     // |
-    float scale_x, float scale_y,   // | IN : Parameters
-    float offset_x, float offset_y, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y;
     calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
 
@@ -2060,15 +2564,17 @@ __kernel void GEN_Value2(
     noise[index] = GetValue2(param.m_frequency, param.m_smoothing, param.m_seed, x, y);
 }
 __kernel void GEN_ValueFractal2(
-    Snapshot param,                 // IN : class members
-
-    ulong size_x, ulong size_y,     // |
-    float scale_x, float scale_y,   // | IN : Parameters
-    float offset_x, float offset_y, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y;
     calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
 
@@ -2078,15 +2584,17 @@ __kernel void GEN_ValueFractal2(
     noise[index] = GetValueFractal2(param.m_fractalType, param.m_frequency, param.m_lacunarity, param.m_gain, param.m_octaves, param.m_fractalBounding, param.m_smoothing, param.m_seed, x, y);
 }
 __kernel void GEN_Perlin2(
-    Snapshot param,                 // IN : class members
-
-    ulong size_x, ulong size_y,     // |
-    float scale_x, float scale_y,   // | IN : Parameters
-    float offset_x, float offset_y, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y;
     calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
 
@@ -2096,15 +2604,17 @@ __kernel void GEN_Perlin2(
     noise[index] = GetPerlin2(param.m_frequency, param.m_smoothing, param.m_seed, x, y);
 }
 __kernel void GEN_PerlinFractal2(
-    Snapshot param,                 // IN : class members
-
-    ulong size_x, ulong size_y,     // |
-    float scale_x, float scale_y,   // | IN : Parameters
-    float offset_x, float offset_y, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y;
     calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
 
@@ -2114,15 +2624,17 @@ __kernel void GEN_PerlinFractal2(
     noise[index] = GetPerlinFractal2(param.m_frequency, param.m_fractalType, param.m_octaves, param.m_lacunarity, param.m_gain, param.m_fractalBounding, param.m_smoothing, param.m_seed, x, y);
 }
 __kernel void GEN_Simplex2(
-    Snapshot param,                 // IN : class members
-
-    ulong size_x, ulong size_y,     // |
-    float scale_x, float scale_y,   // | IN : Parameters
-    float offset_x, float offset_y, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y;
     calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
 
@@ -2132,15 +2644,17 @@ __kernel void GEN_Simplex2(
     noise[index] = GetSimplex2(param.m_frequency, param.m_seed, x, y);
 }
 __kernel void GEN_SimplexFractal2(
-    Snapshot param,                 // IN : class members
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    ulong size_x, ulong size_y,     // |
-    float scale_x, float scale_y,   // | IN : Parameters
-    float offset_x, float offset_y, // |
-
-    __global float* noise)          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y;
     calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
 
@@ -2150,15 +2664,17 @@ __kernel void GEN_SimplexFractal2(
     noise[index] = GetSimplexFractal2(param.m_frequency, param.m_fractalType, param.m_octaves, param.m_lacunarity, param.m_gain, param.m_fractalBounding, param.m_seed, x, y);
 }
 __kernel void GEN_Cellular2(
-    Snapshot param,                 // IN : class members
-
-    ulong size_x, ulong size_y,     // |
-    float scale_x, float scale_y,   // | IN : Parameters
-    float offset_x, float offset_y, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y;
     calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
 
@@ -2168,15 +2684,17 @@ __kernel void GEN_Cellular2(
     noise[index] = GetCellular2(param.m_frequency, param.m_cellularDistanceFunction, param.m_cellularReturnType, param.m_cellularJitter, param.m_cellularDistanceIndex0, param.m_cellularDistanceIndex1, param.m_seed, x, y);
 }
 __kernel void GEN_WhiteNoise2(
-    Snapshot param,                 // IN : class members
-
-    ulong size_x, ulong size_y,     // |
-    float scale_x, float scale_y,   // | IN : Parameters
-    float offset_x, float offset_y, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y;
     calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
 
@@ -2188,15 +2706,17 @@ __kernel void GEN_WhiteNoise2(
 
 //3D
 __kernel void GEN_Value3(
-    Snapshot param,                                 // IN : class members
-
-    ulong size_x, ulong size_y, ulong size_z,       // |
-    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
-    float offset_x, float offset_y, float offset_z, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)                          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1], scale_z = launch->m_scale[2];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1], offset_z = launch->m_offset[2];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y, z;
     calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
 
@@ -2206,15 +2726,17 @@ __kernel void GEN_Value3(
     noise[index] = GetValue3(param.m_frequency, param.m_smoothing, param.m_seed, x, y, z);
 }
 __kernel void GEN_ValueFractal3(
-    Snapshot param,                                 // IN : class members
-
-    ulong size_x, ulong size_y, ulong size_z,       // |
-    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
-    float offset_x, float offset_y, float offset_z, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)                          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1], scale_z = launch->m_scale[2];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1], offset_z = launch->m_offset[2];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y, z;
     calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
 
@@ -2224,15 +2746,17 @@ __kernel void GEN_ValueFractal3(
     noise[index] = GetValueFractal3(param.m_frequency, param.m_fractalType, param.m_lacunarity, param.m_gain, param.m_octaves, param.m_fractalBounding, param.m_smoothing, param.m_seed, x, y, z);
 }
 __kernel void GEN_Perlin3(
-    Snapshot param,                                 // IN : class members
-
-    ulong size_x, ulong size_y, ulong size_z,       // |
-    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
-    float offset_x, float offset_y, float offset_z, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)                          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1], scale_z = launch->m_scale[2];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1], offset_z = launch->m_offset[2];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y, z;
     calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
 
@@ -2242,15 +2766,17 @@ __kernel void GEN_Perlin3(
     noise[index] = GetPerlin3(param.m_frequency, param.m_smoothing, param.m_seed, x, y, z);
 }
 __kernel void GEN_PerlinFractal3(
-    Snapshot param,                                 // IN : class members
-
-    ulong size_x, ulong size_y, ulong size_z,       // |
-    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
-    float offset_x, float offset_y, float offset_z, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)                          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1], scale_z = launch->m_scale[2];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1], offset_z = launch->m_offset[2];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y, z;
     calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
 
@@ -2260,15 +2786,17 @@ __kernel void GEN_PerlinFractal3(
     noise[index] = GetPerlinFractal3(param.m_frequency, param.m_fractalType, param.m_octaves, param.m_lacunarity, param.m_gain, param.m_fractalBounding, param.m_smoothing, param.m_seed, x, y, z);
 }
 __kernel void GEN_Simplex3(
-    Snapshot param,                                 // IN : class members
-
-    ulong size_x, ulong size_y, ulong size_z,       // |
-    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
-    float offset_x, float offset_y, float offset_z, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)                          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1], scale_z = launch->m_scale[2];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1], offset_z = launch->m_offset[2];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y, z;
     calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
 
@@ -2278,15 +2806,17 @@ __kernel void GEN_Simplex3(
     noise[index] = GetSimplex3(param.m_frequency, param.m_seed, x, y, z);
 }
 __kernel void GEN_SimplexFractal3(
-    Snapshot param,                                 // IN : class members
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    ulong size_x, ulong size_y, ulong size_z,       // |
-    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
-    float offset_x, float offset_y, float offset_z, // |
-
-    __global float* noise)                          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1], scale_z = launch->m_scale[2];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1], offset_z = launch->m_offset[2];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y, z;
     calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
 
@@ -2296,15 +2826,17 @@ __kernel void GEN_SimplexFractal3(
     noise[index] = GetSimplexFractal3(param.m_frequency, param.m_fractalType, param.m_octaves, param.m_lacunarity, param.m_gain, param.m_fractalBounding, param.m_seed, x, y, z);
 }
 __kernel void GEN_Cellular3(
-    Snapshot param,                                 // IN : class members
-
-    ulong size_x, ulong size_y, ulong size_z,       // |
-    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
-    float offset_x, float offset_y, float offset_z, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)                          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1], scale_z = launch->m_scale[2];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1], offset_z = launch->m_offset[2];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y, z;
     calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
 
@@ -2314,15 +2846,17 @@ __kernel void GEN_Cellular3(
     noise[index] = GetCellular3(param.m_frequency, param.m_cellularDistanceFunction, param.m_cellularReturnType, param.m_cellularJitter, param.m_cellularDistanceIndex0, param.m_cellularDistanceIndex1, param.m_seed, x, y, z);
 }
 __kernel void GEN_WhiteNoise3(
-    Snapshot param,                                 // IN : class members
-
-    ulong size_x, ulong size_y, ulong size_z,       // |
-    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
-    float offset_x, float offset_y, float offset_z, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)                          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1], scale_z = launch->m_scale[2];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1], offset_z = launch->m_offset[2];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y, z;
     calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
 
@@ -2334,15 +2868,17 @@ __kernel void GEN_WhiteNoise3(
 
 //4D
 __kernel void GEN_Simplex4(
-    Snapshot param,                                                 // IN : class members
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    ulong size_x, ulong size_y, ulong size_z, ulong size_w,         // |
-    float scale_x, float scale_y, float scale_z, float scale_w,     // | IN : Parameters
-    float offset_x, float offset_y, float offset_z, float offset_w, // |
-
-    __global float* noise)                                          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2], size_w = launch->m_size[3];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1], scale_z = launch->m_scale[2], scale_w = launch->m_scale[3];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1], offset_z = launch->m_offset[2], offset_w = launch->m_offset[3];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y, z, w;
     calculate_coord4(index, size_x, size_y, size_z, size_w, scale_x, scale_y, scale_z, scale_w, offset_x, offset_y, offset_z, offset_w, &x, &y, &z, &w); // Calculate coordinates
 
@@ -2350,15 +2886,17 @@ __kernel void GEN_Simplex4(
     noise[index] = GetSimplex4(param.m_frequency, param.m_seed, x, y, z, w);
 }
 __kernel void GEN_WhiteNoise4(
-    Snapshot param,                                                 // IN : class members
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    ulong size_x, ulong size_y, ulong size_z, ulong size_w,         // |
-    float scale_x, float scale_y, float scale_z, float scale_w,     // | IN : Parameters
-    float offset_x, float offset_y, float offset_z, float offset_w, // |
-
-    __global float* noise)                                          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    Snapshot param = launch_chain(launch)[0];
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2], size_w = launch->m_size[3];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1], scale_z = launch->m_scale[2], scale_w = launch->m_scale[3];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1], offset_z = launch->m_offset[2], offset_w = launch->m_offset[3];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y, z, w;
     calculate_coord4(index, size_x, size_y, size_z, size_w, scale_x, scale_y, scale_z, scale_w, offset_x, offset_y, offset_z, offset_w, &x, &y, &z, &w); // Calculate coordinates
     //Calculate value
@@ -2560,21 +3098,23 @@ void SingleCellular3L(int m_cellularDistanceFunction, float m_cellularJitter,
  */
 
 __kernel void GEN_Lookup_Cellular2(
-    __global Snapshot* params, ulong size_p, // IN : members of all classes
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    ulong size_x, ulong size_y,              // |
-    float scale_x, float scale_y,            // | IN : Parameters
-    float offset_x, float offset_y,          // |
-
-    __global float* noise)                   // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    __constant Snapshot* params = launch_chain(launch);
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y;
     calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
 
     //Calculate value
     int err = 0;
-    for (ulong i = 0; i < size_p; i++) {
+    for (uint i = 0; i < launch->m_count; i++) {
         Snapshot p = params[i];
 
         apply_perturb2(&p, &x, &y);
@@ -2626,26 +3166,28 @@ __kernel void GEN_Lookup_Cellular2(
 }
 
 __kernel void GEN_Lookup_Cellular3(
-    __global Snapshot* params, ulong size_p,        // IN : members of all classes
-
-    ulong size_x, ulong size_y, ulong size_z,       // |
-    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
-    float offset_x, float offset_y, float offset_z, // |
+    __constant LaunchParams* launch, // IN : ranges and snapshot chain
 
-    __global float* noise)                          // OUT : Noise matrix
+    __global float* noise)           // OUT : Noise matrix
 {
+    __constant Snapshot* params = launch_chain(launch);
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2];
+    float scale_x = launch->m_scale[0], scale_y = launch->m_scale[1], scale_z = launch->m_scale[2];
+    float offset_x = launch->m_offset[0], offset_y = launch->m_offset[1], offset_z = launch->m_offset[2];
+
     size_t index = get_global_id(0); // Get Index
+    noise -= get_global_offset(0);   // Output starts at first sample of slice
     float x, y, z;
     calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
 
     //Calculate value
     int err = 0;
-    for (ulong i = 0; i < size_p; i++) {
+    for (uint i = 0; i < launch->m_count; i++) {
         Snapshot p = params[i];
 
         apply_perturb3(&p, &x, &y, &z);
 
-        switch(params[i].m_noiseType) {
+        switch(p.m_noiseType) {
         case 0:
             noise[index] = GetValue3(p.m_frequency, p.m_smoothing, p.m_seed, x * p.m_cellularJitter, y * p.m_cellularJitter, z * p.m_cellularJitter);
             return;
@@ -2692,5 +3234,1157 @@ __kernel void GEN_Lookup_Cellular3(
     }
 }
 
+//Tiles
+__kernel void GEN_Tiles2(
+    Snapshot param,                 // IN : class members
+
+    __global float* tiles,          // IN : offset_x, offset_y, scale_x, scale_y of every tile
+    ulong size_x, ulong size_y,     // IN : size of one tile
+
+    __global float* noise)          // OUT : Tiles, one after another
+{
+    size_t index = get_global_id(0); // Get Index
+    size_t tile_size = size_x * size_y;
+    size_t t = index / tile_size;
+
+    __global float* tile = tiles + t * 4;
+    float x, y;
+    calculate_coord2(index - t * tile_size, size_x, size_y, tile[2], tile[3], tile[0], tile[1], &x, &y); // Calculate coordinates
+
+    //Calculate value
+    noise[index] = GetNoise2(&param, x, y);
+}
+
+//Boxes
+#define BOX_STRIDE 7 // Same as BOX_STRIDE in KernelAdapter.cpp
+
+/* Boxes of different size in one dispatch, sample (i, j, k) of a box is at origin + (start + index) * step
+ * so a sample gets the same coordinates whichever box it is generated in.
+ */
+__kernel void GEN_Boxes3(
+    Snapshot param,                 // IN : class members
+
+    __global float* origins,        // IN : origin_x, origin_y, origin_z, step of every box
+    __global long* boxes,           // IN : start_x, start_y, start_z, size_x, size_y, size_z, first sample of every box
+    ulong count,                    // IN : number of boxes
+
+    __global float* noise)          // OUT : Boxes, one after another
+{
+    size_t index = get_global_id(0); // Get Index
+
+    // Box holding index, first samples are ascending
+    ulong low = 0, high = count - 1;
+    while (low < high) {
+        ulong mid = (low + high + 1) / 2;
+        if (boxes[mid * BOX_STRIDE + 6] <= (long)index) low = mid;
+        else high = mid - 1;
+    }
+    __global long* box = boxes + low * BOX_STRIDE;
+    __global float* origin = origins + low * 4;
+
+    size_t size_x = box[3], size_y = box[4];
+    size_t local = index - box[6];
+    size_t k = local / (size_x * size_y);
+    size_t i = (local - k * size_x * size_y) / size_y;
+    size_t j = local - k * size_x * size_y - i * size_y;
+
+    float x = (box[0] + (long)i) * origin[3] + origin[0];
+    float y = (box[1] + (long)j) * origin[3] + origin[1];
+    float z = (box[2] + (long)k) * origin[3] + origin[2];
+
+    //Calculate value
+    noise[index] = GetNoise3(&param, x, y, z);
+}
+
+//Biomes
+#define BIOME_BLEND_MAX 8
+
+/* Weights of biomes around sample (i, j), biome of own map cell comes first with weight 1.
+ * Other biomes get 1 - distance / blend, distance is measured in samples to the closest sample of their cell.
+ */
+int biome_weights(
+    __global uchar* biomes, ulong map_x, ulong map_y, ulong cell, float blend,
+    long i, long j,
+    uchar* ids, float* weights
+) {
+    long c = (long)cell;
+    long mi = min(i / c, (long)map_x - 1);
+    long mj = min(j / c, (long)map_y - 1);
+
+    ids[0] = biomes[mi * map_y + mj];
+    weights[0] = 1.0f;
+    if (blend <= 0) return 1;
+
+    int count = 1;
+    long r = (long)ceil(blend / c);
+    for (long a = max(mi - r, 0L); a <= min(mi + r, (long)map_x - 1); a++) {
+        for (long b = max(mj - r, 0L); b <= min(mj + r, (long)map_y - 1); b++) {
+            float dx = max(max((float)(a * c - i), 0.0f), (float)(i - (a * c + c - 1)));
+            float dy = max(max((float)(b * c - j), 0.0f), (float)(j - (b * c + c - 1)));
+            float w = 1.0f - sqrt(dx * dx + dy * dy) / blend;
+            if (w <= 0) continue;
+
+            uchar id = biomes[a * map_y + b];
+            int n = 0;
+            while (n < count && ids[n] != id) n++;
+            if (n < count) {
+                weights[n] = max(weights[n], w);
+            } else if (count < BIOME_BLEND_MAX) {
+                ids[count] = id;
+                weights[count] = w;
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+//Biome order, counting sort of one slice by biome of own cell
+uchar biome_own(__global uchar* biomes, ulong map_x, ulong map_y, ulong cell, ulong size_y, ulong index) {
+    ulong i = index / size_y;
+    ulong j = index - i * size_y;
+    return biomes[min(i / cell, map_x - 1) * map_y + min(j / cell, map_y - 1)];
+}
+
+__kernel void BIOME_Count(
+    __global uchar* biomes, ulong map_x, ulong map_y, // |
+    ulong cell,                                       // | IN : Biome map
+    ulong size_y,                                     // IN : samples along y
+
+    __global uint* counts)                            // OUT : samples of every biome, 256 zeroed entries
+{
+    size_t index = get_global_id(0);
+    atomic_inc(&counts[biome_own(biomes, map_x, map_y, cell, size_y, index)]);
+}
+
+__kernel void BIOME_Scan(
+    __global uint* counts)                            // IN/OUT : samples of every biome, replaced by first slot
+{
+    uint sum = 0;
+    for (int b = 0; b < 256; b++) {
+        uint c = counts[b];
+        counts[b] = sum;
+        sum += c;
+    }
+}
+
+__kernel void BIOME_Scatter(
+    __global uchar* biomes, ulong map_x, ulong map_y, // |
+    ulong cell,                                       // | IN : Biome map
+    ulong size_y,                                     // IN : samples along y
+    __global uint* first,                             // IN/OUT : next slot of every biome
+
+    __global uint* order)                             // OUT : slice indices grouped by biome
+{
+    size_t index = get_global_id(0);
+    order[atomic_inc(&first[biome_own(biomes, map_x, map_y, cell, size_y, index)])] = (uint)index;
+}
+
+__kernel void GEN_Biome2(
+    __global Snapshot* params, ulong size_p,          // IN : members of every biome
+
+    __global uchar* biomes, ulong map_x, ulong map_y, // |
+    ulong cell, float blend,                          // | IN : Biome map
+    __global uint* order,                             // IN : slice indices grouped by biome
+
+    ulong size_x, ulong size_y,                       // |
+    float scale_x, float scale_y,                     // | IN : Parameters
+    float offset_x, float offset_y,                   // |
+
+    __global float* noise)                            // OUT : Noise matrix
+{
+    size_t index = order[get_global_id(0)]; // Get Index
+    float x, y;
+    calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
+
+    uchar ids[BIOME_BLEND_MAX];
+    float weights[BIOME_BLEND_MAX];
+    long i = index / size_y;
+    int count = biome_weights(biomes, map_x, map_y, cell, blend, i, index - i * size_y, ids, weights);
+
+    //Calculate value
+    float sum = 0, total = 0;
+    for (int n = 0; n < count; n++) {
+        if (ids[n] >= size_p) continue;
+        Snapshot p = params[ids[n]];
+        sum += GetNoise2(&p, x, y) * weights[n];
+        total += weights[n];
+    }
+    noise[index] = total > 0 ? sum / total : 0.0f;
+}
+
+__kernel void GEN_Biome3(
+    __global Snapshot* params, ulong size_p,          // IN : members of every biome
+
+    __global uchar* biomes, ulong map_x, ulong map_y, // |
+    ulong cell, float blend,                          // | IN : Biome map
+    __global uint* order,                             // IN : slice indices grouped by biome
+
+    ulong size_x, ulong size_y, ulong size_z,         // |
+    float scale_x, float scale_y, float scale_z,      // | IN : Parameters
+    float offset_x, float offset_y, float offset_z,   // |
+
+    __global float* noise)                            // OUT : Noise matrix
+{
+    size_t slice = get_global_id(0) / (size_x * size_y); // Get Index, every slice uses the same order
+    size_t index = slice * size_x * size_y + order[get_global_id(0) - slice * size_x * size_y];
+    float x, y, z;
+    calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
+
+    uchar ids[BIOME_BLEND_MAX];
+    float weights[BIOME_BLEND_MAX];
+    size_t plane = index % (size_x * size_y);
+    long i = plane / size_y;
+    int count = biome_weights(biomes, map_x, map_y, cell, blend, i, plane - i * size_y, ids, weights);
+
+    //Calculate value
+    float sum = 0, total = 0;
+    for (int n = 0; n < count; n++) {
+        if (ids[n] >= size_p) continue;
+        Snapshot p = params[ids[n]];
+        sum += GetNoise3(&p, x, y, z) * weights[n];
+        total += weights[n];
+    }
+    noise[index] = total > 0 ? sum / total : 0.0f;
+}
+
+//Octaves
+float SingleOctave2(Snapshot* param, int seed, float x, float y) {
+    switch(param->m_noiseType) {
+    case 1:
+        return SingleValue2(param->m_smoothing, seed, x, y);
+    case 3:
+        return SinglePerlin2(param->m_smoothing, seed, x, y);
+    case 5:
+        return SingleSimplex2(seed, x, y);
+    default:
+        return 0.0f;
+    }
+}
+float SingleOctave3(Snapshot* param, int seed, float x, float y, float z) {
+    switch(param->m_noiseType) {
+    case 1:
+        return SingleValue3(param->m_smoothing, seed, x, y, z);
+    case 3:
+        return SinglePerlin3(param->m_smoothing, seed, x, y, z);
+    case 5:
+        return SingleSimplex3(seed, x, y, z);
+    default:
+        return 0.0f;
+    }
+}
+float OctaveValue(int m_fractalType, int octave, float value, float amp) {
+    switch(m_fractalType) {
+    case 0:
+        return value * amp;
+    case 1:
+        return (FastAbs(value) * 2 - 1) * amp;
+    case 2:
+        return octave == 0 ? 1 - FastAbs(value) : -(1 - FastAbs(value)) * amp;
+    default:
+        return 0.0f;
+    }
+}
+// Octave o uses seed + o, frequency * lacunarity^o and gain^o, stepped serially like the fractal functions
+float GetOctaves2(Snapshot* param, int first, int last, float x, float y) {
+    int seed = param->m_seed;
+    float amp = 1;
+    x *= param->m_frequency;
+    y *= param->m_frequency;
+
+    for (int i = 0; i < first; i++) {
+        x *= param->m_lacunarity;
+        y *= param->m_lacunarity;
+        amp *= param->m_gain;
+        seed++;
+    }
+
+    float sum = 0;
+    for (int i = first; i < last; i++) {
+        sum += OctaveValue(param->m_fractalType, i, SingleOctave2(param, seed, x, y), amp);
+
+        x *= param->m_lacunarity;
+        y *= param->m_lacunarity;
+        amp *= param->m_gain;
+        seed++;
+    }
+
+    return param->m_fractalType == 2 ? sum : sum * param->m_fractalBounding;
+}
+float GetOctaves3(Snapshot* param, int first, int last, float x, float y, float z) {
+    int seed = param->m_seed;
+    float amp = 1;
+    x *= param->m_frequency;
+    y *= param->m_frequency;
+    z *= param->m_frequency;
+
+    for (int i = 0; i < first; i++) {
+        x *= param->m_lacunarity;
+        y *= param->m_lacunarity;
+        z *= param->m_lacunarity;
+        amp *= param->m_gain;
+        seed++;
+    }
+
+    float sum = 0;
+    for (int i = first; i < last; i++) {
+        sum += OctaveValue(param->m_fractalType, i, SingleOctave3(param, seed, x, y, z), amp);
+
+        x *= param->m_lacunarity;
+        y *= param->m_lacunarity;
+        z *= param->m_lacunarity;
+        amp *= param->m_gain;
+        seed++;
+    }
+
+    return param->m_fractalType == 2 ? sum : sum * param->m_fractalBounding;
+}
+
+__kernel void GEN_Octaves2(
+    Snapshot param,                 // IN : class members
+    int first, int last,            // IN : octaves [first, last)
+
+    ulong size_x, ulong size_y,     // |
+    float scale_x, float scale_y,   // | IN : Parameters
+    float offset_x, float offset_y, // |
+
+    __global float* noise)          // IN/OUT : Noise matrix to add octaves to
+{
+    size_t index = get_global_id(0); // Get Index
+    float x, y;
+    calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
+
+    apply_perturb2(&param, &x, &y); // Apply perturb
+
+    //Calculate value
+    noise[index] += GetOctaves2(&param, first, last, x, y);
+}
+__kernel void GEN_Octaves3(
+    Snapshot param,                                 // IN : class members
+    int first, int last,                            // IN : octaves [first, last)
+
+    ulong size_x, ulong size_y, ulong size_z,       // |
+    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
+    float offset_x, float offset_y, float offset_z, // |
+
+    __global float* noise)                          // IN/OUT : Noise matrix to add octaves to
+{
+    size_t index = get_global_id(0); // Get Index
+    float x, y, z;
+    calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
+
+    apply_perturb3(&param, &x, &y, &z); // Apply perturb
+
+    //Calculate value
+    noise[index] += GetOctaves3(&param, first, last, x, y, z);
+}
+
+//Mesh
+__kernel void GEN_Displace3(
+    Snapshot param,                    // IN : class members
+    float scale,                       // IN : displacement per unit of noise
+
+    __global const float* positions,   // IN : 3 floats per vertex
+    __global const float* normals,     // IN : 3 floats per vertex
+
+    __global float* result)            // OUT : displaced positions
+{
+    size_t index = get_global_id(0) * 3; // Get Index
+    float x = positions[index], y = positions[index + 1], z = positions[index + 2];
+
+    //Calculate value
+    float d = GetNoise3(&param, x, y, z) * scale;
+
+    result[index] = x + normals[index] * d;
+    result[index + 1] = y + normals[index + 1] * d;
+    result[index + 2] = z + normals[index + 2] * d;
+}
+__kernel void GEN_FaceNormals3(
+    __global const uint* indices,      // IN : 3 vertices per triangle
+    __global const float* positions,   // IN : displaced positions
+
+    __global float* result)            // OUT : area weighted face normals
+{
+    size_t index = get_global_id(0) * 3; // Get Index
+    size_t a = indices[index] * 3, b = indices[index + 1] * 3, c = indices[index + 2] * 3;
+
+    float ux = positions[b] - positions[a], uy = positions[b + 1] - positions[a + 1], uz = positions[b + 2] - positions[a + 2];
+    float vx = positions[c] - positions[a], vy = positions[c + 1] - positions[a + 1], vz = positions[c + 2] - positions[a + 2];
+
+    result[index] = uy * vz - uz * vy;
+    result[index + 1] = uz * vx - ux * vz;
+    result[index + 2] = ux * vy - uy * vx;
+}
+__kernel void GEN_VertexNormals3(
+    __global const uint* offsets,      // | IN : triangles of vertex v are faces[offsets[v]] .. faces[offsets[v + 1] - 1]
+    __global const uint* faces,        // |
+    __global const float* faceNormals, // IN : area weighted face normals
+    __global const float* normals,     // IN : kept for vertices without triangles
+
+    __global float* result)            // OUT : smooth normals
+{
+    size_t vertex = get_global_id(0); // Get Index
+    float x = 0, y = 0, z = 0;
+
+    for (uint i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+        size_t f = faces[i] * 3;
+        x += faceNormals[f];
+        y += faceNormals[f + 1];
+        z += faceNormals[f + 2];
+    }
+
+    size_t index = vertex * 3;
+    float len = sqrt(x * x + y * y + z * z);
+    if (len > 0) {
+        result[index] = x / len;
+        result[index + 1] = y / len;
+        result[index + 2] = z / len;
+    } else {
+        result[index] = normals[index];
+        result[index + 1] = normals[index + 1];
+        result[index + 2] = normals[index + 2];
+    }
+}
+
+//Points
+__kernel void GEN_Points2(
+    Snapshot param,                 // IN : class members
+    __global const float* points,   // IN : 2 floats per point
+
+    __global float* noise)          // OUT : Noise array
+{
+    size_t index = get_global_id(0); // Get Index
+
+    //Calculate value
+    noise[index] = GetNoise2(&param, points[index * 2], points[index * 2 + 1]);
+}
+__kernel void GEN_Points3(
+    Snapshot param,                 // IN : class members
+    __global const float* points,   // IN : 3 floats per point
+
+    __global float* noise)          // OUT : Noise array
+{
+    size_t index = get_global_id(0); // Get Index
+
+    //Calculate value
+    noise[index] = GetNoise3(&param, points[index * 3], points[index * 3 + 1], points[index * 3 + 2]);
+}
+
+//Approximate perturb
+__kernel void GEN_PerturbField2(
+    Snapshot param,                 // IN : class members
+
+    ulong size_x, ulong size_y,     // |
+    float scale_x, float scale_y,   // | IN : Parameters of coarse grid
+    float offset_x, float offset_y, // |
+
+    __global float* field)          // OUT : 2 floats of displacement per coarse sample
+{
+    size_t index = get_global_id(0); // Get Index
+    float x, y;
+    calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
+
+    float px = x, py = y;
+    apply_perturb2(&param, &px, &py); // Apply perturb
+
+    field[index * 2] = px - x;
+    field[index * 2 + 1] = py - y;
+}
+__kernel void GEN_PerturbField3(
+    Snapshot param,                                 // IN : class members
+
+    ulong size_x, ulong size_y, ulong size_z,       // |
+    float scale_x, float scale_y, float scale_z,    // | IN : Parameters of coarse grid
+    float offset_x, float offset_y, float offset_z, // |
+
+    __global float* field)                          // OUT : 3 floats of displacement per coarse sample
+{
+    size_t index = get_global_id(0); // Get Index
+    float x, y, z;
+    calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
+
+    float px = x, py = y, pz = z;
+    apply_perturb3(&param, &px, &py, &pz); // Apply perturb
+
+    field[index * 3] = px - x;
+    field[index * 3 + 1] = py - y;
+    field[index * 3 + 2] = pz - z;
+}
+__kernel void GEN_PerturbApprox2(
+    Snapshot param,                 // IN : class members
+    ulong factor,                   // IN : samples per coarse cell along each axis
+    __global const float* field,    // IN : displacement of coarse grid, (size - 1) / factor + 2 samples per axis
+
+    ulong size_x, ulong size_y,     // |
+    float scale_x, float scale_y,   // | IN : Parameters
+    float offset_x, float offset_y, // |
+
+    __global float* noise)          // OUT : Noise matrix
+{
+    size_t index = get_global_id(0); // Get Index
+    float x, y;
+    calculate_coord2(index, size_x, size_y, scale_x, scale_y, offset_x, offset_y, &x, &y); // Calculate coordinates
+
+    size_t i = index / size_y;
+    size_t j = index - i * size_y;
+    size_t ci = i / factor, cj = j / factor;
+    float tx = (float)(i - ci * factor) / factor;
+    float ty = (float)(j - cj * factor) / factor;
+
+    size_t fy = (size_y - 1) / factor + 2;
+    size_t c0 = (ci * fy + cj) * 2;
+    size_t c1 = c0 + fy * 2;
+
+    //Interpolate perturb
+    x += Lerp(Lerp(field[c0], field[c0 + 2], ty), Lerp(field[c1], field[c1 + 2], ty), tx);
+    y += Lerp(Lerp(field[c0 + 1], field[c0 + 3], ty), Lerp(field[c1 + 1], field[c1 + 3], ty), tx);
+
+    //Calculate value
+    param.m_perturb = 0;
+    noise[index] = GetNoise2(&param, x, y);
+}
+float field_lerp3(__global const float* field, size_t c0, size_t dx, size_t dz, float tx, float ty, float tz) {
+    size_t c1 = c0 + dx, c2 = c0 + dz, c3 = c0 + dz + dx;
+    return Lerp(
+        Lerp(Lerp(field[c0], field[c0 + 3], ty), Lerp(field[c1], field[c1 + 3], ty), tx),
+        Lerp(Lerp(field[c2], field[c2 + 3], ty), Lerp(field[c3], field[c3 + 3], ty), tx),
+        tz);
+}
+__kernel void GEN_PerturbApprox3(
+    Snapshot param,                                 // IN : class members
+    ulong factor,                                   // IN : samples per coarse cell along each axis
+    __global const float* field,                    // IN : displacement of coarse grid, (size - 1) / factor + 2 samples per axis
+
+    ulong size_x, ulong size_y, ulong size_z,       // |
+    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
+    float offset_x, float offset_y, float offset_z, // |
+
+    __global float* noise)                          // OUT : Noise matrix
+{
+    size_t index = get_global_id(0); // Get Index
+    float x, y, z;
+    calculate_coord3(index, size_x, size_y, size_z, scale_x, scale_y, scale_z, offset_x, offset_y, offset_z, &x, &y, &z); // Calculate coordinates
+
+    size_t k = index / (size_x * size_y);
+    size_t i = (index - k * size_x * size_y) / size_y;
+    size_t j = index - k * size_x * size_y - i * size_y;
+    size_t ci = i / factor, cj = j / factor, ck = k / factor;
+    float tx = (float)(i - ci * factor) / factor;
+    float ty = (float)(j - cj * factor) / factor;
+    float tz = (float)(k - ck * factor) / factor;
+
+    size_t fx = (size_x - 1) / factor + 2;
+    size_t fy = (size_y - 1) / factor + 2;
+    size_t c0 = ((ck * fx + ci) * fy + cj) * 3;
+
+    //Interpolate perturb
+    x += field_lerp3(field, c0, fy * 3, fx * fy * 3, tx, ty, tz);
+    y += field_lerp3(field, c0 + 1, fy * 3, fx * fy * 3, tx, ty, tz);
+    z += field_lerp3(field, c0 + 2, fy * 3, fx * fy * 3, tx, ty, tz);
+
+    //Calculate value
+    param.m_perturb = 0;
+    noise[index] = GetNoise3(&param, x, y, z);
+}
+
+//Levels
+// Maps id to the n-th sample of a fine plane that has no coarse sample (odd i or odd j)
+void refine_coord2(size_t id, size_t size_y, size_t* i, size_t* j) {
+    size_t cy = (size_y + 1) / 2;
+    size_t block = cy - 1 + size_y; // even row: odd j only, odd row: every j
+    size_t a = id / block;
+    size_t r = id - a * block;
+
+    if (r < cy - 1) {
+        *i = 2 * a;
+        *j = 2 * r + 1;
+    } else {
+        *i = 2 * a + 1;
+        *j = r - (cy - 1);
+    }
+}
+__kernel void GEN_Inject2(
+    ulong coarse_y, ulong size_y,   // IN : sizes along y of coarse and fine grid
+    __global const float* coarse,   // IN : previous level
+
+    __global float* noise)          // OUT : samples of fine grid with even i and j
+{
+    size_t index = get_global_id(0); // Get Index
+    size_t a = index / coarse_y;
+    size_t b = index - a * coarse_y;
+
+    noise[2 * a * size_y + 2 * b] = coarse[index];
+}
+__kernel void GEN_Inject3(
+    ulong coarse_x, ulong coarse_y,   // IN : sizes of coarse grid
+    ulong size_x, ulong size_y,       // IN : sizes of fine grid
+    __global const float* coarse,     // IN : previous level
+
+    __global float* noise)            // OUT : samples of fine grid with even i, j and k
+{
+    size_t index = get_global_id(0); // Get Index
+    size_t c = index / (coarse_x * coarse_y);
+    size_t a = (index - c * coarse_x * coarse_y) / coarse_y;
+    size_t b = index - c * coarse_x * coarse_y - a * coarse_y;
+
+    noise[(2 * c * size_x + 2 * a) * size_y + 2 * b] = coarse[index];
+}
+__kernel void GEN_Refine2(
+    Snapshot param,                 // IN : class members
+
+    ulong size_x, ulong size_y,     // |
+    float scale_x, float scale_y,   // | IN : Parameters of fine grid
+    float offset_x, float offset_y, // |
+
+    __global float* noise)          // OUT : samples of fine grid without coarse sample
+{
+    size_t i, j;
+    refine_coord2(get_global_id(0), size_y, &i, &j); // Get Index
+
+    //Calculate value
+    noise[i * size_y + j] = GetNoise2(&param, i * scale_x + offset_x, j * scale_y + offset_y);
+}
+__kernel void GEN_Refine3(
+    Snapshot param,                                 // IN : class members
+
+    ulong size_x, ulong size_y, ulong size_z,       // |
+    float scale_x, float scale_y, float scale_z,    // | IN : Parameters of fine grid
+    float offset_x, float offset_y, float offset_z, // |
+
+    __global float* noise)                          // OUT : samples of fine grid without coarse sample
+{
+    size_t id = get_global_id(0); // Get Index
+    size_t plane = size_x * size_y;
+    size_t planeNew = plane - ((size_x + 1) / 2) * ((size_y + 1) / 2);
+    size_t c = id / (planeNew + plane); // even layer: refined plane, odd layer: every sample
+    size_t r = id - c * (planeNew + plane);
+
+    size_t i, j, k;
+    if (r < planeNew) {
+        k = 2 * c;
+        refine_coord2(r, size_y, &i, &j);
+    } else {
+        k = 2 * c + 1;
+        i = (r - planeNew) / size_y;
+        j = r - planeNew - i * size_y;
+    }
+
+    //Calculate value
+    noise[(k * size_x + i) * size_y + j] = GetNoise3(&param, i * scale_x + offset_x, j * scale_y + offset_y, k * scale_z + offset_z);
+}
+
+//Axis grids
+__kernel void GEN_Grid2(
+    Snapshot param,               // IN : class members
+
+    ulong size_x, ulong size_y,   // |
+    __global const float* axes,   // | IN : x coordinates followed by y coordinates
+
+    __global float* noise)        // OUT : Noise matrix
+{
+    size_t index = get_global_id(0); // Get Index
+    size_t i = index / size_y;
+    size_t j = index - i * size_y;
+
+    //Calculate value
+    noise[index] = GetNoise2(&param, axes[i], axes[size_x + j]);
+}
+__kernel void GEN_Grid3(
+    Snapshot param,                           // IN : class members
+
+    ulong size_x, ulong size_y, ulong size_z, // |
+    __global const float* axes,               // | IN : x coordinates followed by y and z coordinates
+
+    __global float* noise)                    // OUT : Noise matrix
+{
+    size_t index = get_global_id(0); // Get Index
+    size_t k = index / (size_x * size_y);
+    size_t i = (index - k * size_x * size_y) / size_y;
+    size_t j = index - k * size_x * size_y - i * size_y;
+
+    //Calculate value
+    noise[index] = GetNoise3(&param, axes[i], axes[size_x + j], axes[size_x + size_y + k]);
+}
+
+//Block compression
+// Encodes 16 values in [0, 255] as one BC4 block, tries quality sets of endpoints moved inwards from min and max
+ulong encode_bc4(float* v, int quality) {
+    float mn = v[0], mx = v[0];
+    for (int t = 1; t < 16; t++) {
+        mn = min(mn, v[t]);
+        mx = max(mx, v[t]);
+    }
+
+    ulong best = (ulong)(uint)(mn + 0.5f) | ((ulong)(uint)(mn + 0.5f) << 8); // Flat block, every index 0
+    float bestErr = 1e30f;
+    for (int s = 0; s < max(quality, 1); s++) {
+        float inset = (mx - mn) * s / 32.0f;
+        uint e0 = (uint)(mx - inset + 0.5f), e1 = (uint)(mn + inset + 0.5f);
+        if (e0 <= e1) break;
+
+        // 8 value mode: e0, e1, then 6 values from e0 to e1
+        float palette[8];
+        palette[0] = e0;
+        palette[1] = e1;
+        for (int i = 2; i < 8; i++) palette[i] = ((8 - i) * (float)e0 + (i - 1) * (float)e1) / 7.0f;
+
+        ulong indices = 0;
+        float err = 0;
+        for (int t = 0; t < 16; t++) {
+            int bi = 0;
+            float bd = fabs(v[t] - palette[0]);
+            for (int i = 1; i < 8; i++) {
+                float d = fabs(v[t] - palette[i]);
+                if (d < bd) {
+                    bd = d;
+                    bi = i;
+                }
+            }
+            indices |= (ulong)bi << (3 * t);
+            err += bd * bd;
+        }
+
+        if (err < bestErr) {
+            bestErr = err;
+            best = (ulong)e0 | ((ulong)e1 << 8) | (indices << 16);
+        }
+    }
+
+    return best;
+}
+// Evaluates the 4x4 texels of block (bi, bj), rows along x and columns along y, edges repeat the last sample
+void block_values(Snapshot* param, size_t bi, size_t bj,
+    ulong size_x, ulong size_y, float scale_x, float scale_y, float offset_x, float offset_y,
+    float low, float high, float* v
+) {
+    float scale = high > low ? 255.0f / (high - low) : 0.0f;
+    for (int t = 0; t < 16; t++) {
+        size_t i = min(bi * 4 + t / 4, (size_t)(size_x - 1));
+        size_t j = min(bj * 4 + t % 4, (size_t)(size_y - 1));
+        float n = GetNoise2(param, i * scale_x + offset_x, j * scale_y + offset_y);
+        v[t] = clamp((n - low) * scale, 0.0f, 255.0f);
+    }
+}
+__kernel void GEN_BC4(
+    Snapshot param,                 // IN : class members
+
+    ulong size_x, ulong size_y,     // |
+    float scale_x, float scale_y,   // | IN : Parameters
+    float offset_x, float offset_y, // |
+
+    float low, float high,          // IN : range mapped to 0 - 255
+    int quality,                    // IN : endpoint candidates per block
+
+    __global ulong* blocks)         // OUT : BC4 blocks, y fastest
+{
+    size_t index = get_global_id(0); // Get Index
+    size_t blocks_y = (size_y + 3) / 4;
+    size_t bi = index / blocks_y;
+    size_t bj = index - bi * blocks_y;
+
+    float v[16];
+    block_values(&param, bi, bj, size_x, size_y, scale_x, scale_y, offset_x, offset_y, low, high, v);
+    blocks[index] = encode_bc4(v, quality);
+}
+__kernel void GEN_BC5(
+    Snapshot red,                   // IN : class members of first channel
+    Snapshot green,                 // IN : class members of second channel
+
+    ulong size_x, ulong size_y,     // |
+    float scale_x, float scale_y,   // | IN : Parameters
+    float offset_x, float offset_y, // |
+
+    float low, float high,          // IN : range mapped to 0 - 255
+    int quality,                    // IN : endpoint candidates per block
+
+    __global ulong* blocks)         // OUT : BC5 blocks, y fastest
+{
+    size_t index = get_global_id(0); // Get Index
+    size_t blocks_y = (size_y + 3) / 4;
+    size_t bi = index / blocks_y;
+    size_t bj = index - bi * blocks_y;
+
+    float v[16];
+    block_values(&red, bi, bj, size_x, size_y, scale_x, scale_y, offset_x, offset_y, low, high, v);
+    blocks[index * 2] = encode_bc4(v, quality);
+    block_values(&green, bi, bj, size_x, size_y, scale_x, scale_y, offset_x, offset_y, low, high, v);
+    blocks[index * 2 + 1] = encode_bc4(v, quality);
+}
+
+//Selection
+// Maps float to uint with the same order
+uint float_key(float f) {
+    uint u = as_uint(f);
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+}
+__kernel void SEL_Histogram(
+    __global const float* data, ulong size, // IN : generated samples
+    uint prefix, uint mask,                 // IN : only keys with (key & mask) == prefix are counted
+    int shift,                              // IN : position of counted digit
+
+    __global uint* histogram)               // OUT : 256 bins, added to
+{
+    __local uint bins[256];
+    for (size_t b = get_local_id(0); b < 256; b += get_local_size(0)) bins[b] = 0;
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for (size_t i = get_global_id(0); i < size; i += get_global_size(0)) {
+        uint key = float_key(data[i]);
+        if ((key & mask) == prefix) atomic_inc(&bins[(key >> shift) & 255]);
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for (size_t b = get_local_id(0); b < 256; b += get_local_size(0))
+        if (bins[b]) atomic_add(&histogram[b], bins[b]);
+}
+__kernel void SEL_Mask(
+    __global const float* data,     // IN : generated samples
+    float threshold,                // IN : lowest marked value
+
+    __global uchar* mask)           // OUT : 1 for samples at or above threshold, else 0
+{
+    size_t index = get_global_id(0); // Get Index
+    mask[index] = data[index] >= threshold;
+}
+
+//Worms
+#define WORM_PI 3.14159265f
+#define WORM_PITCH_MAX 1.4f       // Keeps worms from turning straight up or down
+#define WORM_PITCH_DAMPING 0.75f  // Pulls pitch back towards level every step
+#define WORM_DECORRELATE 1024.0f  // Offset between yaw and pitch samples of steering noise
+
+__kernel void GEN_Worms3(
+    Snapshot steer,                     // IN : class members of steering noise
+
+    __global const float* starts,       // IN : x, y, z and radius of every worm
+    uint steps, float step, float turn, // IN : path length, distance per step, radians per unit of noise / PI
+
+    __global float* path)               // OUT : steps + 1 points of 4 floats per worm
+{
+    size_t worm = get_global_id(0); // Get Index
+    __global float* out = path + worm * (steps + 1) * 4;
+
+    float x = starts[worm * 4], y = starts[worm * 4 + 1], z = starts[worm * 4 + 2], radius = starts[worm * 4 + 3];
+    float yaw = GetNoise3(&steer, x, y + WORM_DECORRELATE, z) * WORM_PI * 2.0f;
+    float pitch = 0.0f;
+
+    out[0] = x; out[1] = y; out[2] = z; out[3] = radius;
+    for (uint s = 1; s <= steps; s++) {
+        yaw += GetNoise3(&steer, x, y, z) * turn * WORM_PI;
+        pitch = pitch * WORM_PITCH_DAMPING + GetNoise3(&steer, x + WORM_DECORRELATE, y, z) * turn * WORM_PI;
+        pitch = clamp(pitch, -WORM_PITCH_MAX, WORM_PITCH_MAX);
+
+        x += cos(yaw) * cos(pitch) * step;
+        y += sin(yaw) * cos(pitch) * step;
+        z += sin(pitch) * step;
+
+        out[s * 4] = x; out[s * 4 + 1] = y; out[s * 4 + 2] = z; out[s * 4 + 3] = radius;
+    }
+}
+
+void carve_bounds(float a, float b, float r, float scale, float offset, ulong size, long* first, long* last) {
+    if (scale == 0.0f) { // Every sample shares the coordinate, distance test decides
+        *first = 0;
+        *last = (long)size - 1;
+        return;
+    }
+    float lo = (min(a, b) - r - offset) / scale;
+    float hi = (max(a, b) + r - offset) / scale;
+    *first = max((long)ceil(min(lo, hi)), 0L);
+    *last = min((long)floor(max(lo, hi)), (long)size - 1);
+}
+__kernel void GEN_Carve3(
+    __global const float* path, uint steps,         // IN : points of GEN_Worms3
+
+    ulong size_x, ulong size_y, ulong size_z,       // |
+    float scale_x, float scale_y, float scale_z,    // | IN : Parameters
+    float offset_x, float offset_y, float offset_z, // |
+
+    __global int* carve)                            // OUT : strength bits per sample, maximum of all segments
+{
+    size_t segment = get_global_id(0); // Get Index
+    size_t worm = segment / steps;
+    __global const float* a = path + (segment + worm) * 4;
+    __global const float* b = a + 4;
+
+    float r = max(a[3], b[3]);
+    if (r <= 0.0f) return;
+
+    long i0, i1, j0, j1, k0, k1;
+    carve_bounds(a[0], b[0], r, scale_x, offset_x, size_x, &i0, &i1);
+    carve_bounds(a[1], b[1], r, scale_y, offset_y, size_y, &j0, &j1);
+    carve_bounds(a[2], b[2], r, scale_z, offset_z, size_z, &k0, &k1);
+
+    float dx = b[0] - a[0], dy = b[1] - a[1], dz = b[2] - a[2];
+    float len = dx * dx + dy * dy + dz * dz;
+
+    for (long k = k0; k <= k1; k++)
+    for (long i = i0; i <= i1; i++)
+    for (long j = j0; j <= j1; j++) {
+        float px = i * scale_x + offset_x - a[0];
+        float py = j * scale_y + offset_y - a[1];
+        float pz = k * scale_z + offset_z - a[2];
+
+        //Closest point of segment, radius is interpolated along it
+        float t = len > 0.0f ? clamp((px * dx + py * dy + pz * dz) / len, 0.0f, 1.0f) : 0.0f;
+        float rt = a[3] + (b[3] - a[3]) * t;
+        px -= t * dx; py -= t * dy; pz -= t * dz;
+
+        float strength = 1.0f - (px * px + py * py + pz * pz) / (rt * rt);
+        if (strength > 0.0f) atomic_max(&carve[(k * size_x + i) * size_y + j], as_int(strength)); // Positive floats order like their bits
+    }
+}
+__kernel void GEN_CarveApply3(
+    __global const int* carve, // IN : strength bits of GEN_Carve3
+    float depth,               // IN : density removed at full strength
+
+    __global float* density)   // OUT : Noise matrix, carved in place
+{
+    size_t index = get_global_id(0); // Get Index
+    density[index] -= depth * as_float(carve[index]);
+}
+
+//Chunk cache
+/*
+ * Open-addressing table of resident chunks, 4 ints per entry: chunk x, y, z and pool slot, slot -1 marks free entries
+ *   Chunk c covers samples c * (chunk_size - 1) ... c * (chunk_size - 1) + chunk_size - 1 of every axis,
+ *   neighbouring chunks share their edge samples. Samples of a chunk are stored like Generator output.
+ *   chunk_hash must match the host side in Generator.cpp
+ */
+uint chunk_hash(int x, int y, int z) {
+    uint h = (uint)x * 0x8DA6B343u ^ (uint)y * 0xD8163841u ^ (uint)z * 0xCB1AB31Fu;
+    return h ^ (h >> 16);
+}
+int chunk_find(__global const int* table, uint mask, int x, int y, int z) {
+    uint h = chunk_hash(x, y, z) & mask;
+    for (uint n = 0; n <= mask; n++, h = (h + 1) & mask) {
+        __global const int* e = table + h * 4;
+        if (e[3] < 0) return -1;
+        if (e[0] == x && e[1] == y && e[2] == z) return e[3];
+    }
+    return -1;
+}
+void chunk_miss(
+    __global uint* set, uint mask,                                 // IN : chunks already queued, 0 marks free entries
+    __global int* misses, __global uint* count, uint max_misses,   // OUT : 3 ints per missed chunk
+    int x, int y, int z
+) {
+    uint key = chunk_hash(x, y, z) | 1u; // Chunks with equal hash are queued once per gather
+    uint h = key & mask;
+    for (uint n = 0; n <= mask; n++, h = (h + 1) & mask) {
+        uint old = atomic_cmpxchg(&set[h], 0u, key);
+        if (old == key) return;
+        if (old == 0u) {
+            uint q = atomic_inc(count);
+            if (q < max_misses) {
+                misses[q * 3] = x;
+                misses[q * 3 + 1] = y;
+                misses[q * 3 + 2] = z;
+            }
+            return;
+        }
+    }
+}
+
+__kernel void CACHE_Fill2(
+    Snapshot param,                         // IN : class members
+    __global const int* chunks,             // IN : chunk x, y, z and pool slot of every generated chunk
+    uint chunk_size, float step,            // IN : samples per axis and distance between them
+
+    __global float* pool)                   // OUT : chunk_size^2 samples per slot
+{
+    size_t index = get_global_id(0); // Get Index
+    size_t samples = chunk_size * chunk_size;
+    size_t c = index / samples;
+    size_t s = index - c * samples;
+    int i = s / chunk_size, j = s - i * chunk_size;
+    __global const int* chunk = chunks + c * 4;
+    int span = chunk_size - 1;
+
+    //Calculate value
+    pool[chunk[3] * samples + s] = GetNoise2(&param, (chunk[0] * span + i) * step, (chunk[1] * span + j) * step);
+}
+__kernel void CACHE_Fill3(
+    Snapshot param,                         // IN : class members
+    __global const int* chunks,             // IN : chunk x, y, z and pool slot of every generated chunk
+    uint chunk_size, float step,            // IN : samples per axis and distance between them
+
+    __global float* pool)                   // OUT : chunk_size^3 samples per slot
+{
+    size_t index = get_global_id(0); // Get Index
+    size_t samples = chunk_size * chunk_size * chunk_size;
+    size_t c = index / samples;
+    size_t s = index - c * samples;
+    int k = s / (chunk_size * chunk_size);
+    int i = (s - k * chunk_size * chunk_size) / chunk_size;
+    int j = s - k * chunk_size * chunk_size - i * chunk_size;
+    __global const int* chunk = chunks + c * 4;
+    int span = chunk_size - 1;
+
+    //Calculate value
+    pool[chunk[3] * samples + s] = GetNoise3(&param, (chunk[0] * span + i) * step, (chunk[1] * span + j) * step, (chunk[2] * span + k) * step);
+}
+
+__kernel void CACHE_Gather2(
+    Snapshot param,                                 // IN : class members, used on miss
+    __global const int* table, uint table_mask,     // IN : resident chunks
+    __global const float* pool,                     // IN : chunk samples
+    uint chunk_size, float step,                    // IN : samples per axis and distance between them
+    __global const float* points,                   // IN : 2 floats per point
+
+    __global uint* set, uint set_mask,              // |
+    __global int* misses, __global uint* count,     // | OUT : missed chunks, skipped if max_misses is 0
+    uint max_misses,                                // |
+    __global float* noise)                          // OUT : Noise array
+{
+    size_t index = get_global_id(0); // Get Index
+    float x = points[index * 2], y = points[index * 2 + 1];
+    int span = chunk_size - 1;
+
+    //Find chunk, sample coordinates relative to it
+    float u = x / step, v = y / step;
+    int cx = (int)floor(u / span), cy = (int)floor(v / span);
+    int slot = chunk_find(table, table_mask, cx, cy, 0);
+
+    if (slot >= 0) {
+        u -= cx * span;
+        v -= cy * span;
+        int i = clamp((int)u, 0, span - 1), j = clamp((int)v, 0, span - 1);
+        float fx = u - i, fy = v - j;
+        __global const float* c = pool + (size_t)slot * chunk_size * chunk_size + i * chunk_size + j;
+
+        //Interpolate
+        noise[index] = Lerp(Lerp(c[0], c[1], fy), Lerp(c[chunk_size], c[chunk_size + 1], fy), fx);
+        return;
+    }
+
+    //Calculate value
+    noise[index] = GetNoise2(&param, x, y);
+    if (max_misses) chunk_miss(set, set_mask, misses, count, max_misses, cx, cy, 0);
+}
+__kernel void CACHE_Gather3(
+    Snapshot param,                                 // IN : class members, used on miss
+    __global const int* table, uint table_mask,     // IN : resident chunks
+    __global const float* pool,                     // IN : chunk samples
+    uint chunk_size, float step,                    // IN : samples per axis and distance between them
+    __global const float* points,                   // IN : 3 floats per point
+
+    __global uint* set, uint set_mask,              // |
+    __global int* misses, __global uint* count,     // | OUT : missed chunks, skipped if max_misses is 0
+    uint max_misses,                                // |
+    __global float* noise)                          // OUT : Noise array
+{
+    size_t index = get_global_id(0); // Get Index
+    float x = points[index * 3], y = points[index * 3 + 1], z = points[index * 3 + 2];
+    int span = chunk_size - 1;
+
+    //Find chunk, sample coordinates relative to it
+    float u = x / step, v = y / step, w = z / step;
+    int cx = (int)floor(u / span), cy = (int)floor(v / span), cz = (int)floor(w / span);
+    int slot = chunk_find(table, table_mask, cx, cy, cz);
+
+    if (slot >= 0) {
+        u -= cx * span;
+        v -= cy * span;
+        w -= cz * span;
+        int i = clamp((int)u, 0, span - 1), j = clamp((int)v, 0, span - 1), k = clamp((int)w, 0, span - 1);
+        float fx = u - i, fy = v - j, fz = w - k;
+        size_t plane = chunk_size * chunk_size;
+        __global const float* c = pool + (size_t)slot * plane * chunk_size + k * plane + i * chunk_size + j;
+        __global const float* d = c + plane;
+
+        //Interpolate
+        float lower = Lerp(Lerp(c[0], c[1], fy), Lerp(c[chunk_size], c[chunk_size + 1], fy), fx);
+        float upper = Lerp(Lerp(d[0], d[1], fy), Lerp(d[chunk_size], d[chunk_size + 1], fy), fx);
+        noise[index] = Lerp(lower, upper, fz);
+        return;
+    }
+
+    //Calculate value
+    noise[index] = GetNoise3(&param, x, y, z);
+    if (max_misses) chunk_miss(set, set_mask, misses, count, max_misses, cx, cy, cz);
+}
+
+//Brickmap
+#define BRICK_SIZE 8 // Samples per brick axis, must match Generator.h
+
+//Bricks past the edge repeat the last sample
+float brick_sample(
+    __constant LaunchParams* launch, Snapshot* param,
+    size_t brick, size_t sample,
+    float low, float high
+) {
+    ulong size_x = launch->m_size[0], size_y = launch->m_size[1], size_z = launch->m_size[2];
+    ulong bricks_x = (size_x + BRICK_SIZE - 1) / BRICK_SIZE, bricks_y = (size_y + BRICK_SIZE - 1) / BRICK_SIZE;
+    ulong bk = brick / (bricks_x * bricks_y);
+    ulong bi = (brick - bk * bricks_x * bricks_y) / bricks_y;
+    ulong bj = brick - bk * bricks_x * bricks_y - bi * bricks_y;
+
+    ulong k = sample / (BRICK_SIZE * BRICK_SIZE);
+    ulong i = (sample - k * BRICK_SIZE * BRICK_SIZE) / BRICK_SIZE;
+    ulong j = sample - k * BRICK_SIZE * BRICK_SIZE - i * BRICK_SIZE;
+
+    ulong xi = min(bi * BRICK_SIZE + i, size_x - 1);
+    ulong yi = min(bj * BRICK_SIZE + j, size_y - 1);
+    ulong zi = min(bk * BRICK_SIZE + k, size_z - 1);
+    float x = xi * launch->m_scale[0] + launch->m_offset[0];
+    float y = yi * launch->m_scale[1] + launch->m_offset[1];
+    float z = zi * launch->m_scale[2] + launch->m_offset[2];
+    return clamp(GetNoise3(param, x, y, z), low, high);
+}
+__kernel void BRICK_Classify(
+    __constant LaunchParams* launch,            // IN : ranges and snapshot chain
+    float low, float high,                      // IN : values are clamped to this range first
+    float epsilon,                              // IN : largest distance to the brick value
+
+    __global int* table)                        // OUT : 1 if brick is not uniform else 0, followed by bits of brick value
+{
+    __local float lo[BRICK_SIZE * BRICK_SIZE];
+    __local float hi[BRICK_SIZE * BRICK_SIZE];
+
+    Snapshot param = launch_chain(launch)[0];
+    size_t brick = get_group_id(0);  // One group per brick
+    size_t column = get_local_id(0); // One work item per column along z
+
+    //Generate brick, only its range is kept
+    float l = high, h = low;
+    for (size_t k = 0; k < BRICK_SIZE; k++) {
+        float v = brick_sample(launch, &param, brick, k * BRICK_SIZE * BRICK_SIZE + column, low, high);
+        l = min(l, v);
+        h = max(h, v);
+    }
+    lo[column] = l;
+    hi[column] = h;
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for (size_t s = BRICK_SIZE * BRICK_SIZE / 2; s > 0; s /= 2) {
+        if (column < s) {
+            lo[column] = min(lo[column], lo[column + s]);
+            hi[column] = max(hi[column], hi[column + s]);
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    if (column) return;
+
+    float value = lo[0] + (hi[0] - lo[0]) * 0.5f;
+    table[brick * 2] = value - lo[0] > epsilon || hi[0] - value > epsilon;
+    table[brick * 2 + 1] = as_int(value);
+}
+__kernel void BRICK_Fill(
+    __constant LaunchParams* launch,            // IN : ranges and snapshot chain
+    float low, float high,                      // IN : values are clamped to this range
+    __global const uint* bricks,                // IN : brick stored at every pool entry
+
+    __global float* pool)                       // OUT : BRICK_SIZE^3 samples per entry, stored like Generator output
+{
+    Snapshot param = launch_chain(launch)[0];
+    size_t index = get_global_id(0); // Get Index
+    size_t entry = index / (BRICK_SIZE * BRICK_SIZE * BRICK_SIZE);
+    size_t sample = index - entry * BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+
+    pool[index] = brick_sample(launch, &param, bricks[entry], sample, low, high);
+}
+
 )===="
 
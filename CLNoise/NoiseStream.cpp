@@ -0,0 +1,86 @@
+// NoiseStream.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#include "NoiseStream.h"
+
+#include <cstring>
+
+// initialization
+NoiseStream::NoiseStream(Generator& generator, size_t blockSize, size_t blockCount, float step, double start) : m_generator(generator) {
+    m_blockSize = blockSize ? blockSize : 1;
+    m_blockCount = blockCount > 1 ? blockCount : 2;
+    m_step = step;
+
+    m_ring.resize(m_blockSize * m_blockCount, 0.0f);
+    seek(start);
+}
+NoiseStream::~NoiseStream() {}
+
+// Streaming
+const float* NoiseStream::next() {
+    if (m_returned == m_generated && !refill()) return nullptr;
+
+    size_t block = (size_t)((m_returned / m_blockSize) % m_blockCount);
+    m_returned += m_blockSize;
+
+    return m_ring.data() + block * m_blockSize;
+}
+void NoiseStream::seek(double position) {
+    m_start = position;
+    m_generated = 0;
+    m_returned = 0;
+}
+bool NoiseStream::refill() {
+    size_t blocks = m_blockCount / 2;
+
+    // Offset is computed in double from sample index, so rounding does not add up from block to block.
+    // Kernels still take it as float: once |offset| gets near step * 2^23 consecutive samples
+    // snap to the float grid, seek closer to the origin to keep full precision
+    float offset = (float)(m_start + (double)m_generated * m_step);
+    NoiseBuffer b = m_generator.getNoise(Range(blocks * m_blockSize, offset, m_step));
+    if (!b.size) return false;
+
+    size_t first = (size_t)((m_generated / m_blockSize) % m_blockCount);
+    for (size_t i = 0; i < blocks; i++) {
+        size_t block = (first + i) % m_blockCount;
+        std::memcpy(m_ring.data() + block * m_blockSize, b.data + i * m_blockSize, sizeof(float) * m_blockSize);
+    }
+    m_generated += blocks * m_blockSize;
+
+    return true;
+}
+
+// Getters/Setters
+double NoiseStream::getPosition() const {
+    return m_start + (double)m_returned * m_step;
+}
+size_t NoiseStream::getBlockSize() const {
+    return m_blockSize;
+}
+size_t NoiseStream::getBlockCount() const {
+    return m_blockCount;
+}
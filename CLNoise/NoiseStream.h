@@ -0,0 +1,80 @@
+// NoiseStream.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef NoiseStream_H
+#define NoiseStream_H
+
+#include <cstdlib>
+#include <vector>
+#include "Generator.h"
+
+//! \brief streams 1D noise in fixed size blocks, e.g. audio frames
+class NoiseStream {
+public:
+    /*! \brief Create stream
+     * Ring holds blockCount blocks of blockSize samples, half of the ring is
+     * generated in one dispatch whenever it runs empty
+     * \param step distance between two samples, e.g. frequency / sample rate
+     * \param start coordinate of the first sample
+     * Coordinates reach the kernels as float, so samples stay distinct only while
+     * |position| is well below step * 2^23, about 3 minutes of 48 kHz audio for start 0
+     */
+    NoiseStream(Generator& generator, size_t blockSize, size_t blockCount = 4, float step = 1.0f, double start = 0.0);
+    ~NoiseStream();
+
+    /*! \brief Returns next block of blockSize samples
+     * Block continues exactly where the previous one ended and stays valid
+     * for at least blockCount / 2 following calls. Returns nullptr if the
+     * Noise set on generator has no 1D version
+     */
+    const float* next();
+    //! \brief Restarts stream at given coordinate, drops generated blocks
+    void seek(double position);
+
+    // Getters/Setters
+    //! \brief Coordinate of the first sample of the block returned by next call
+    double getPosition() const;
+    size_t getBlockSize() const;
+    size_t getBlockCount() const;
+
+protected:
+    Generator& m_generator;
+    size_t m_blockSize;
+    size_t m_blockCount;
+    float m_step;
+
+    double m_start;
+    unsigned long long m_generated; // samples generated since start
+    unsigned long long m_returned;  // samples returned since start
+
+    std::vector<float> m_ring;
+
+private:
+    bool refill();
+};
+
+#endif
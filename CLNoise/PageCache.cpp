@@ -0,0 +1,179 @@
+// PageCache.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#include "PageCache.h"
+
+#include <cmath>
+#include <cstring>
+#include <unordered_set>
+
+unsigned long long page_key(const PageRequest& page) {
+    return ((unsigned long long)(page.layer & 0xff) << 56) |
+           ((unsigned long long)(page.mip & 0xff) << 48) |
+           ((unsigned long long)(page.x & 0xffffff) << 24) |
+           (unsigned long long)(page.y & 0xffffff);
+}
+
+// initialization
+PageCache::PageCache(Generator& generator, size_t pageSize, size_t slotsX, size_t slotsY, float baseStep) : m_generator(generator) {
+    m_pageSize = pageSize;
+    m_slotsX = slotsX;
+    m_slotsY = slotsY;
+    m_baseStep = baseStep;
+
+    m_atlas.resize(slotsX * slotsY * pageSize * pageSize, 0.0f);
+    clear();
+}
+PageCache::~PageCache() {}
+
+// Pages
+size_t PageCache::update(const PageRequest* requests, size_t count) {
+    // Drop duplicates, mark resident pages as used
+    std::vector<PageRequest> missing;
+    std::unordered_set<unsigned long long> seen;
+    size_t used = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        unsigned long long key = page_key(requests[i]);
+        if (!seen.insert(key).second) continue;
+
+        auto e = m_table.find(key);
+        if (e != m_table.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, e->second.lru);
+            used++;
+        } else {
+            missing.push_back(requests[i]);
+        }
+    }
+
+    // Pages used this frame are in front of the list and are never evicted
+    size_t available = m_freeSlots.size() + (m_lru.size() - used);
+    if (missing.size() > available) missing.resize(available);
+    if (missing.empty()) return 0;
+
+    // Assign slots
+    std::vector<int> slots(missing.size());
+    for (size_t i = 0; i < missing.size(); i++) {
+        if (!m_freeSlots.empty()) {
+            slots[i] = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            auto e = m_table.find(m_lru.back());
+            slots[i] = e->second.slot;
+            m_table.erase(e);
+            m_lru.pop_back();
+        }
+
+        unsigned long long key = page_key(missing[i]);
+        m_lru.push_front(key);
+        m_table[key] = Entry{ slots[i], m_lru.begin() };
+    }
+
+    // Generate pages, one dispatch per layer
+    Noise* previous = m_generator.getNoise();
+    std::vector<bool> done(missing.size(), false);
+    size_t generated = 0;
+
+    for (size_t i = 0; i < missing.size(); i++) {
+        if (done[i]) continue;
+        int layer = missing[i].layer;
+
+        std::vector<size_t> batch;
+        std::vector<Range> x, y;
+        for (size_t j = i; j < missing.size(); j++) {
+            if (done[j] || missing[j].layer != layer) continue;
+            done[j] = true;
+
+            const PageRequest& p = missing[j];
+            float step = std::ldexp(m_baseStep, p.mip);
+            float span = step * m_pageSize;
+
+            batch.push_back(j);
+            x.push_back(Range(m_pageSize, p.x * span, step));
+            y.push_back(Range(m_pageSize, p.y * span, step));
+        }
+
+        auto l = m_layers.find(layer);
+        m_generator.setNoise(l != m_layers.end() ? l->second : previous);
+
+        NoiseBuffer b = m_generator.getTiles(x.data(), y.data(), batch.size());
+        if (b.size) {
+            for (size_t j = 0; j < batch.size(); j++)
+                copyToAtlas(b.data + j * m_pageSize * m_pageSize, slots[batch[j]]);
+            generated += batch.size();
+        } else {
+            // Not generated, give the slots back
+            for (size_t j = 0; j < batch.size(); j++) {
+                auto e = m_table.find(page_key(missing[batch[j]]));
+                m_lru.erase(e->second.lru);
+                m_table.erase(e);
+                m_freeSlots.push_back(slots[batch[j]]);
+            }
+        }
+    }
+    m_generator.setNoise(previous);
+
+    return generated;
+}
+int PageCache::getSlot(const PageRequest& page) const {
+    auto e = m_table.find(page_key(page));
+    return e == m_table.end() ? -1 : e->second.slot;
+}
+void PageCache::clear() {
+    m_lru.clear();
+    m_table.clear();
+
+    m_freeSlots.clear();
+    for (size_t i = m_slotsX * m_slotsY; i > 0; i--)
+        m_freeSlots.push_back((int)(i - 1));
+}
+
+void PageCache::copyToAtlas(const float* page, int slot) {
+    size_t height = getAtlasHeight();
+    size_t column = (slot / m_slotsY) * m_pageSize;
+    size_t row = (slot % m_slotsY) * m_pageSize;
+
+    for (size_t i = 0; i < m_pageSize; i++)
+        std::memcpy(&m_atlas[(column + i) * height + row], page + i * m_pageSize, sizeof(float) * m_pageSize);
+}
+
+// Getters/Setters
+void PageCache::setLayer(int layer, Noise* noise) {
+    m_layers[layer] = noise;
+}
+const float* PageCache::getAtlas() const {
+    return m_atlas.data();
+}
+size_t PageCache::getAtlasWidth() const {
+    return m_slotsX * m_pageSize;
+}
+size_t PageCache::getAtlasHeight() const {
+    return m_slotsY * m_pageSize;
+}
+size_t PageCache::getPageSize() const {
+    return m_pageSize;
+}
@@ -0,0 +1,104 @@
+// PageCache.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef PageCache_H
+#define PageCache_H
+
+#include <cstdlib>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include "Generator.h"
+
+//! \brief address of a virtual texture page, as written to the feedback buffer
+struct PageRequest {
+    int x;
+    int y;
+    int mip;
+    int layer;
+};
+
+//! \brief generates virtual texture pages on demand into a physical page atlas
+class PageCache {
+public:
+    /*! \brief Create page cache
+     * Atlas holds slotsX * slotsY pages of pageSize * pageSize samples
+     * \param baseStep distance between samples of mip 0, doubles every mip
+     */
+    PageCache(Generator& generator, size_t pageSize, size_t slotsX, size_t slotsY, float baseStep = 1.0f);
+    ~PageCache();
+
+    /*! \brief Sets Noise object used for pages of the given layer
+     * Layers without own Noise use the one currently set on generator
+     */
+    void setLayer(int layer, Noise* noise);
+
+    /*! \brief Makes requested pages resident
+     * Duplicate requests are dropped, resident pages are only marked as used,
+     * missing pages replace least recently used ones and are generated in one dispatch per layer
+     * \return number of pages generated
+     */
+    size_t update(const PageRequest* requests, size_t count);
+
+    //! \brief Returns atlas slot of a resident page or -1
+    int getSlot(const PageRequest& page) const;
+    //! \brief Drops all resident pages, e.g. after Noise change
+    void clear();
+
+    /*! \brief Returns atlas data
+     * Atlas uses the layout of Generator output, slot s starts at
+     * column (s / slotsY) * pageSize and row (s % slotsY) * pageSize
+     */
+    const float* getAtlas() const;
+    size_t getAtlasWidth() const;
+    size_t getAtlasHeight() const;
+    size_t getPageSize() const;
+
+protected:
+    Generator& m_generator;
+    size_t m_pageSize;
+    size_t m_slotsX;
+    size_t m_slotsY;
+    float m_baseStep;
+
+    std::vector<float> m_atlas;
+    std::unordered_map<int, Noise*> m_layers;
+
+private:
+    struct Entry {
+        int slot;
+        std::list<unsigned long long>::iterator lru;
+    };
+
+    std::list<unsigned long long> m_lru;
+    std::unordered_map<unsigned long long, Entry> m_table;
+    std::vector<int> m_freeSlots;
+
+    void copyToAtlas(const float* page, int slot);
+};
+
+#endif
@@ -0,0 +1,218 @@
+// Pipeline.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#include "Pipeline.h"
+
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <deque>
+
+typedef std::unique_ptr<BakeJob> JobPtr;
+typedef std::chrono::steady_clock PipelineClock;
+
+double seconds_since(PipelineClock::time_point start) {
+    return std::chrono::duration<double>(PipelineClock::now() - start).count();
+}
+
+// Pipeline::impl
+class Pipeline::impl {
+public:
+    struct StageInfo {
+        std::string name;
+        size_t workers;
+        size_t capacity;
+        Stage stage;
+    };
+
+    // Jobs waiting for a stage, and how many run or wait on held back workers
+    struct StageState {
+        std::deque<JobPtr> queue;
+        size_t active = 0;
+        size_t held = 0;
+        PipelineClock::time_point heldSince;
+    };
+
+    std::vector<Generator*> m_generators;
+    std::vector<StageInfo> m_stages;
+    std::vector<StageStats> m_stats;
+
+    // Run state, guarded by m_lock
+    std::mutex m_lock;
+    std::condition_variable m_changed;
+    std::deque<StageState> m_state;
+    std::vector<Generator*> m_idle;
+    size_t m_finished = 0;
+    size_t m_tasks = 0;
+
+    void generate(Generator* generator, BakeJob& job) const {
+        NoiseBuffer b(0, nullptr);
+        switch (job.ranges.size()) {
+        case 2:
+            b = generator->getNoise(job.ranges[0], job.ranges[1]);
+            break;
+        case 3:
+            b = generator->getNoise(job.ranges[0], job.ranges[1], job.ranges[2]);
+            break;
+        default:
+            break;
+        }
+        job.noise.assign(b.data, b.data + b.size);
+    }
+
+    // Jobs between stage s and s + 1 are bounded by queue capacity plus workers, like a blocking queue
+    bool hasRoom(size_t s) const {
+        if (s + 1 >= m_stages.size()) return true;
+        return m_state[s + 1].queue.size() + m_state[s].active < m_stages[s].capacity + m_stages[s].workers;
+    }
+
+    void start(Executor& executor) {
+        std::vector<Executor::Task> tasks;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+
+            // Later stages first, they make room for earlier ones
+            for (size_t s = m_stages.size(); s-- > 0;) {
+                StageState& st = m_state[s];
+                while (!st.queue.empty() && st.active < m_stages[s].workers && hasRoom(s)) {
+                    st.active++;
+                    m_tasks++;
+                    BakeJob* job = st.queue.front().release();
+                    st.queue.pop_front();
+
+                    Generator* generator = nullptr;
+                    if (s == 0) {
+                        generator = m_idle.back();
+                        m_idle.pop_back();
+                    }
+                    tasks.push_back([this, &executor, s, job, generator] { process(executor, s, job, generator); });
+                }
+
+                // Blocked time counts workers that are free but have nowhere to put results
+                size_t held = st.queue.empty() || hasRoom(s) ? 0 : std::min(st.queue.size(), m_stages[s].workers - st.active);
+                if (st.held) m_stats[s].blocked += st.held * seconds_since(st.heldSince);
+                st.held = held;
+                st.heldSince = PipelineClock::now();
+            }
+        }
+
+        // Submitted outside the lock, executor may run them right away
+        for (size_t i = 0; i < tasks.size(); i++) executor.submit(std::move(tasks[i]));
+    }
+
+    void process(Executor& executor, size_t s, BakeJob* raw, Generator* generator) {
+        JobPtr job(raw);
+
+        PipelineClock::time_point t = PipelineClock::now();
+        if (s == 0) generate(generator, *job);
+        else m_stages[s].stage(*job);
+        double busy = seconds_since(t);
+
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_stats[s].busy += busy;
+            m_stats[s].processed++;
+            m_state[s].active--;
+            if (generator) m_idle.push_back(generator);
+
+            if (s + 1 < m_stages.size()) m_state[s + 1].queue.push_back(std::move(job));
+            else m_finished++;
+        }
+
+        start(executor);
+
+        // Last access of the task, run may return once it sees the count drop
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_tasks--;
+        m_changed.notify_all();
+    }
+};
+
+// Pipeline
+// initialization
+Pipeline::Pipeline(const std::vector<Generator*>& generators, size_t capacity) : rimpl(*(new impl)) {
+    rimpl.m_generators = generators;
+    rimpl.m_stages.push_back(impl::StageInfo{ "generate", generators.size(), capacity, nullptr });
+}
+Pipeline::~Pipeline() {
+    delete &rimpl;
+}
+
+void Pipeline::addStage(const std::string& name, Stage stage, size_t workers, size_t capacity) {
+    rimpl.m_stages.push_back(impl::StageInfo{ name, workers ? workers : 1, capacity, stage });
+}
+
+// Run
+void Pipeline::run(size_t count, const Stage& setup) {
+    if (rimpl.m_generators.empty()) return;
+    size_t stageCount = rimpl.m_stages.size();
+    Executor& executor = rimpl.m_generators[0]->getExecutor();
+
+    rimpl.m_stats.assign(stageCount, StageStats());
+    rimpl.m_state.clear();
+    rimpl.m_state.resize(stageCount);
+    for (size_t s = 0; s < stageCount; s++) {
+        rimpl.m_stats[s].name = rimpl.m_stages[s].name;
+        rimpl.m_stats[s].workers = rimpl.m_stages[s].workers;
+    }
+    rimpl.m_idle = rimpl.m_generators;
+    rimpl.m_finished = 0;
+    rimpl.m_tasks = 0;
+
+    PipelineClock::time_point start = PipelineClock::now();
+
+    // Feed jobs, waits while generation stage is saturated
+    for (size_t i = 0; i < count; i++) {
+        JobPtr job(new BakeJob);
+        job->index = i;
+        setup(*job);
+
+        {
+            std::unique_lock<std::mutex> lock(rimpl.m_lock);
+            rimpl.m_changed.wait(lock, [&] { return rimpl.m_state[0].queue.size() < rimpl.m_stages[0].workers; });
+            rimpl.m_state[0].queue.push_back(std::move(job));
+        }
+        rimpl.start(executor);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(rimpl.m_lock);
+        rimpl.m_changed.wait(lock, [&] { return rimpl.m_finished == count && rimpl.m_tasks == 0; });
+    }
+
+    double elapsed = seconds_since(start);
+    for (size_t s = 0; s < stageCount; s++) {
+        StageStats& st = rimpl.m_stats[s];
+        if (elapsed > 0 && st.workers) st.utilization = st.busy / (elapsed * st.workers);
+    }
+}
+
+// Getters/Setters
+const std::vector<StageStats>& Pipeline::getStats() const {
+    return rimpl.m_stats;
+}
@@ -0,0 +1,101 @@
+// Pipeline.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef Pipeline_H
+#define Pipeline_H
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <functional>
+#include "Generator.h"
+
+//! \brief unit of work passed from one pipeline stage to the next
+class BakeJob {
+public:
+    //! \brief position of the job in the bake
+    size_t index = 0;
+    //! \brief 2 or 3 ranges to generate, set by the job setup function
+    std::vector<Range> ranges;
+
+    //! \brief result of generation stage
+    std::vector<float> noise;
+    //! \brief free to use by later stages (remapped, compressed data, etc.)
+    std::vector<unsigned char> data;
+};
+
+//! \brief statistics of one pipeline stage, collected during Pipeline::run
+class StageStats {
+public:
+    std::string name;
+    size_t workers = 0;
+    size_t processed = 0;
+
+    //! \brief seconds spent processing jobs, summed over workers
+    double busy = 0;
+    //! \brief seconds workers were free but held back by a full next queue, summed over workers
+    double blocked = 0;
+    //! \brief busy time divided by run time of all workers
+    double utilization = 0;
+};
+
+/*! \brief Runs bake jobs through generate -> user stages with bounded queues in between
+ * Every stage runs concurrently with the others, the slowest stage sets throughput.
+ * Queues between stages are bounded, so at most (sum of capacities + workers) jobs exist at once.
+ * Stages run as tasks on the Executor of the first generator, workers limits tasks per stage
+ */
+class Pipeline {
+public:
+    typedef std::function<void(BakeJob&)> Stage;
+
+    /*! \brief Create pipeline
+     * Generation stage gets one worker per generator, all generators should have the same Noise set.
+     * Generators of one device share its kernels, so give each generator its own device
+     * \param capacity size of queue after generation stage
+     */
+    Pipeline(const std::vector<Generator*>& generators, size_t capacity = 4);
+    ~Pipeline();
+
+    /*! \brief Appends a stage after the last one
+     * \param capacity size of queue after this stage, ignored for the last stage
+     */
+    void addStage(const std::string& name, Stage stage, size_t workers = 1, size_t capacity = 4);
+
+    /*! \brief Runs count jobs through all stages, blocks until the last one leaves the pipeline
+     * setup is called for every job before generation and has to fill BakeJob::ranges
+     */
+    void run(size_t count, const Stage& setup);
+
+    //! \brief Returns statistics of last run, generation stage first
+    const std::vector<StageStats>& getStats() const;
+
+private:
+    class impl;
+    impl& rimpl;
+};
+
+#endif
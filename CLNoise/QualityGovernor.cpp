@@ -0,0 +1,157 @@
+// QualityGovernor.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#include "QualityGovernor.h"
+
+#include <chrono>
+#include <algorithm>
+
+bool is_fractal(NoiseType type) {
+    return type == NoiseType::ValueFractal || type == NoiseType::PerlinFractal || type == NoiseType::SimplexFractal;
+}
+
+// GovernedBuffer
+GovernedBuffer::GovernedBuffer(NoiseBuffer&& buffer, QualityLevel quality, double milliseconds) : buffer(std::move(buffer)) {
+    this->quality = quality;
+    this->milliseconds = milliseconds;
+}
+
+// initialization
+QualityGovernor::QualityGovernor(Generator& generator, double targetMs) : m_generator(generator) {
+    m_target = targetMs;
+    m_minOctaves = 1;
+    m_minPerturbOctaves = 1;
+    m_restoreRequests = 8;
+    m_restoreRatio = 0.7f;
+
+    reset();
+}
+QualityGovernor::~QualityGovernor() {}
+
+// Generation
+template<typename F>
+GovernedBuffer QualityGovernor::govern(F generate) {
+    Noise* original = m_generator.getNoise();
+    if (!original) return GovernedBuffer(NoiseBuffer(0, nullptr), QualityLevel{ 0, 0, 0 }, 0);
+
+    // Full quality octave counts
+    int octaves = 0, perturbOctaves = 0;
+    if (is_fractal(original->getNoiseType()) && original->getFractal())
+        octaves = original->getFractal()->getOctaves();
+    const Perturb* perturb = original->getPerturb();
+    if (perturb && perturb->getPerturbType() == PerturbType::Fractal && perturb->getFractal())
+        perturbOctaves = perturb->getFractal()->getOctaves();
+
+    int maxLevel = std::max(std::max(0, octaves - m_minOctaves), std::max(0, perturbOctaves - m_minPerturbOctaves));
+    int level = std::min(m_level, maxLevel);
+
+    QualityLevel quality;
+    quality.level = level;
+    quality.octaves = octaves ? std::max(std::min(octaves, m_minOctaves), octaves - level) : 0;
+    quality.perturbOctaves = perturbOctaves ? std::max(std::min(perturbOctaves, m_minPerturbOctaves), perturbOctaves - level) : 0;
+
+    // Reduced copies, caller objects stay untouched
+    Noise noise = *original;
+    Fractal fractal;
+    Perturb reducedPerturb;
+    Fractal perturbFractal;
+    if (level > 0) {
+        if (octaves) {
+            const Fractal& f = *original->getFractal();
+            fractal = Fractal(quality.octaves, f.getLacunarity(), f.getGain());
+            noise.setFractal(&fractal);
+        }
+        if (perturbOctaves) {
+            const Fractal& f = *perturb->getFractal();
+            reducedPerturb = *perturb;
+            perturbFractal = Fractal(quality.perturbOctaves, f.getLacunarity(), f.getGain());
+            reducedPerturb.setFractal(&perturbFractal);
+            noise.setPerturb(&reducedPerturb);
+        }
+        m_generator.setNoise(&noise);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    NoiseBuffer b = generate();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    m_generator.setNoise(original);
+    update(ms, maxLevel);
+
+    return GovernedBuffer(std::move(b), quality, ms);
+}
+void QualityGovernor::update(double ms, int maxLevel) {
+    if (ms > m_target) {
+        // Over target, drop one level right away
+        m_calm = 0;
+        if (m_level < maxLevel) m_level++;
+    } else if (ms < m_target * m_restoreRatio) {
+        // Raise quality only after several calm requests, so it does not oscillate
+        if (++m_calm >= m_restoreRequests) {
+            m_calm = 0;
+            if (m_level > 0) m_level--;
+        }
+    } else {
+        m_calm = 0;
+    }
+}
+
+GovernedBuffer QualityGovernor::getNoise(const Range& x) {
+    return govern([&]() { return m_generator.getNoise(x); });
+}
+GovernedBuffer QualityGovernor::getNoise(const Range& x, const Range& y) {
+    return govern([&]() { return m_generator.getNoise(x, y); });
+}
+GovernedBuffer QualityGovernor::getNoise(const Range& x, const Range& y, const Range& z) {
+    return govern([&]() { return m_generator.getNoise(x, y, z); });
+}
+GovernedBuffer QualityGovernor::getNoise(const Range& x, const Range& y, const Range& z, const Range& w) {
+    return govern([&]() { return m_generator.getNoise(x, y, z, w); });
+}
+
+// Getters/Setters
+void QualityGovernor::setTarget(double targetMs) {
+    m_target = targetMs;
+}
+double QualityGovernor::getTarget() const {
+    return m_target;
+}
+void QualityGovernor::setFloors(int minOctaves, int minPerturbOctaves) {
+    m_minOctaves = std::max(1, minOctaves);
+    m_minPerturbOctaves = std::max(1, minPerturbOctaves);
+}
+void QualityGovernor::setRestore(int requests, float restoreRatio) {
+    m_restoreRequests = std::max(1, requests);
+    m_restoreRatio = restoreRatio;
+}
+int QualityGovernor::getLevel() const {
+    return m_level;
+}
+void QualityGovernor::reset() {
+    m_level = 0;
+    m_calm = 0;
+}
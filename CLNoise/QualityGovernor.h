@@ -0,0 +1,105 @@
+// QualityGovernor.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef QualityGovernor_H
+#define QualityGovernor_H
+
+#include <cstdlib>
+#include "Generator.h"
+
+//! \brief quality a result was generated with
+struct QualityLevel {
+    //! \brief 0 is full quality, every level removes one octave where floors allow
+    int level;
+    //! \brief fractal octaves used, 0 if Noise is not fractal
+    int octaves;
+    //! \brief perturb octaves used, 0 if perturb is not fractal
+    int perturbOctaves;
+};
+
+//! \brief result of QualityGovernor generation
+class GovernedBuffer {
+public:
+    NoiseBuffer buffer;
+    QualityLevel quality;
+    //! \brief measured generation time
+    double milliseconds;
+
+    GovernedBuffer(NoiseBuffer&& buffer, QualityLevel quality, double milliseconds);
+};
+
+/*! \brief lowers octave counts of the Noise set on generator while latency exceeds target
+ * Quality is restored step by step once latency stays below target. Noise, Fractal and
+ * Perturb objects of the caller are never changed, reduced copies are used instead.
+ * Only the top Noise of a NoiseLookup chain is governed
+ */
+class QualityGovernor {
+public:
+    //! \brief Create governor, targetMs is the latency allowed for one request
+    QualityGovernor(Generator& generator, double targetMs);
+    ~QualityGovernor();
+
+    // Generation
+    GovernedBuffer getNoise(const Range& x);
+    GovernedBuffer getNoise(const Range& x, const Range& y);
+    GovernedBuffer getNoise(const Range& x, const Range& y, const Range& z);
+    GovernedBuffer getNoise(const Range& x, const Range& y, const Range& z, const Range& w);
+
+    // Getters/Setters
+    void setTarget(double targetMs);
+    double getTarget() const;
+    /*! \brief Sets lowest octave counts the governor may use
+     * Default: 1 and 1
+     */
+    void setFloors(int minOctaves, int minPerturbOctaves);
+    /*! \brief Sets number of consecutive requests below restoreRatio * target before quality is raised
+     * Default: 8 and 0.7
+     */
+    void setRestore(int requests, float restoreRatio);
+    //! \brief Returns level the next request will use
+    int getLevel() const;
+    //! \brief Returns to full quality
+    void reset();
+
+protected:
+    Generator& m_generator;
+    double m_target;
+    int m_minOctaves;
+    int m_minPerturbOctaves;
+    int m_restoreRequests;
+    float m_restoreRatio;
+
+    int m_level;
+    int m_calm;
+
+private:
+    template<typename F>
+    GovernedBuffer govern(F generate);
+    void update(double ms, int maxLevel);
+};
+
+#endif
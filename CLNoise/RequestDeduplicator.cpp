@@ -0,0 +1,187 @@
+// RequestDeduplicator.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#include "RequestDeduplicator.h"
+
+#include <string.h>
+
+unsigned long long range_key(const Range& r) {
+    unsigned int offset, step;
+    memcpy(&offset, &r.offset, sizeof(float));
+    memcpy(&step, &r.step, sizeof(float));
+    return ((unsigned long long)offset << 32) | step;
+}
+NoiseBuffer generate_ranges(Generator& generator, const std::vector<Range>& r) {
+    switch (r.size()) {
+    case 1:
+        return generator.getNoise(r[0]);
+    case 2:
+        return generator.getNoise(r[0], r[1]);
+    case 3:
+        return generator.getNoise(r[0], r[1], r[2]);
+    default:
+        return generator.getNoise(r[0], r[1], r[2], r[3]);
+    }
+}
+
+// initialization
+RequestDeduplicator::RequestDeduplicator(Generator& generator) : m_generator(generator) {
+    m_dispatched = 0;
+    m_merged = 0;
+}
+RequestDeduplicator::~RequestDeduplicator() {
+    for (;;) {
+        std::shared_future<SharedBuffer> pending;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (m_pending.empty()) break;
+            pending = m_pending.begin()->second.future;
+        }
+        pending.wait();
+    }
+}
+
+// Requests
+RequestDeduplicator::Key RequestDeduplicator::makeKey(const Noise& noise, const Range* ranges, int dimensions) const {
+    Key key;
+    key.push_back(m_generator.getFingerprint(noise));
+    key.push_back(dimensions);
+    key.push_back(m_generator.getSliceFirst());
+    key.push_back(m_generator.getSliceCount());
+    for (int d = 0; d < dimensions; d++) {
+        key.push_back(ranges[d].size);
+        key.push_back(range_key(ranges[d]));
+    }
+    return key;
+}
+std::shared_future<SharedBuffer> RequestDeduplicator::attach(Noise& noise, const Range* ranges, int dimensions, bool async) {
+    Key key = makeKey(noise, ranges, dimensions);
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    auto p = m_pending.find(key);
+    if (p != m_pending.end()) {
+        m_merged++;
+        Pending pending = p->second;
+        lock.unlock();
+
+        // Sync callers never wait on a dispatch still queued on the executor, they run it themselves
+        if (!async && !pending.claimed->exchange(true)) pending.dispatch();
+        return pending.future;
+    }
+
+    std::shared_ptr<std::promise<SharedBuffer>> promise(new std::promise<SharedBuffer>());
+    Pending pending;
+    pending.future = promise->get_future().share();
+    pending.claimed = std::make_shared<std::atomic<bool>>(!async);
+
+    // Slice is part of key, dispatch restores it in case generator changed since
+    std::vector<Range> r(ranges, ranges + dimensions);
+    size_t first = m_generator.getSliceFirst(), count = m_generator.getSliceCount();
+    pending.dispatch = [this, key, promise, r, first, count, &noise] {
+        SharedBuffer result;
+        {
+            std::lock_guard<std::mutex> g(m_generatorLock);
+            Noise* previous = m_generator.getNoise();
+            size_t previousFirst = m_generator.getSliceFirst(), previousCount = m_generator.getSliceCount();
+            m_generator.setNoise(&noise);
+            m_generator.setSlice(first, count);
+            result = std::make_shared<const NoiseBuffer>(generate_ranges(m_generator, r));
+            m_generator.setSlice(previousFirst, previousCount);
+            m_generator.setNoise(previous);
+        }
+
+        // Later requests dispatch again, result lives as long as someone holds it
+        {
+            std::lock_guard<std::mutex> l(m_lock);
+            m_pending.erase(key);
+        }
+        promise->set_value(result);
+    };
+
+    m_pending[key] = pending;
+    m_dispatched++;
+    lock.unlock();
+
+    if (async) {
+        // Runs only if no sync caller claimed the dispatch before the executor got to it
+        Executor::Task dispatch = pending.dispatch;
+        std::shared_ptr<std::atomic<bool>> claimed = pending.claimed;
+        m_generator.getExecutor().submit([dispatch, claimed] {
+            if (!claimed->exchange(true)) dispatch();
+        });
+    } else {
+        pending.dispatch();
+    }
+
+    return pending.future;
+}
+
+// Generation
+SharedBuffer RequestDeduplicator::getNoise(Noise& noise, const Range& x) {
+    return attach(noise, &x, 1, false).get();
+}
+SharedBuffer RequestDeduplicator::getNoise(Noise& noise, const Range& x, const Range& y) {
+    Range r[] = { x, y };
+    return attach(noise, r, 2, false).get();
+}
+SharedBuffer RequestDeduplicator::getNoise(Noise& noise, const Range& x, const Range& y, const Range& z) {
+    Range r[] = { x, y, z };
+    return attach(noise, r, 3, false).get();
+}
+SharedBuffer RequestDeduplicator::getNoise(Noise& noise, const Range& x, const Range& y, const Range& z, const Range& w) {
+    Range r[] = { x, y, z, w };
+    return attach(noise, r, 4, false).get();
+}
+std::shared_future<SharedBuffer> RequestDeduplicator::requestNoise(Noise& noise, const Range& x) {
+    return attach(noise, &x, 1, true);
+}
+std::shared_future<SharedBuffer> RequestDeduplicator::requestNoise(Noise& noise, const Range& x, const Range& y) {
+    Range r[] = { x, y };
+    return attach(noise, r, 2, true);
+}
+std::shared_future<SharedBuffer> RequestDeduplicator::requestNoise(Noise& noise, const Range& x, const Range& y, const Range& z) {
+    Range r[] = { x, y, z };
+    return attach(noise, r, 3, true);
+}
+std::shared_future<SharedBuffer> RequestDeduplicator::requestNoise(Noise& noise, const Range& x, const Range& y, const Range& z, const Range& w) {
+    Range r[] = { x, y, z, w };
+    return attach(noise, r, 4, true);
+}
+
+// Getters/Setters
+size_t RequestDeduplicator::getDispatched() const {
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_dispatched;
+}
+size_t RequestDeduplicator::getMerged() const {
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_merged;
+}
+size_t RequestDeduplicator::getPending() const {
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_pending.size();
+}
@@ -0,0 +1,101 @@
+// RequestDeduplicator.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef RequestDeduplicator_H
+#define RequestDeduplicator_H
+
+#include <cstdlib>
+#include <map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <atomic>
+#include "Generator.h"
+
+//! \brief result shared by every request that attached to the same dispatch
+typedef std::shared_ptr<const NoiseBuffer> SharedBuffer;
+
+/*! \brief merges identical concurrent requests into one dispatch
+ * Requests are identical when Noise fingerprint, slice of generator, dimensions and ranges match.
+ * A request arriving while an identical one is in flight waits for its result instead of dispatching
+ * again. A sync request finding the dispatch still queued on the Executor runs it on its own thread,
+ * so getNoise is safe to call from Executor tasks.
+ * Entries are dropped as soon as the dispatch finishes, nothing is cached beyond that.
+ * All requests use generator, one at a time, setting their Noise on it for the dispatch.
+ * Noise objects have to stay alive and unchanged until their request finished
+ */
+class RequestDeduplicator {
+public:
+    RequestDeduplicator(Generator& generator);
+    //! \brief Waits for requests in flight
+    ~RequestDeduplicator();
+
+    // Generation, blocks until result is ready. Dispatches on the calling thread if first
+    SharedBuffer getNoise(Noise& noise, const Range& x);
+    SharedBuffer getNoise(Noise& noise, const Range& x, const Range& y);
+    SharedBuffer getNoise(Noise& noise, const Range& x, const Range& y, const Range& z);
+    SharedBuffer getNoise(Noise& noise, const Range& x, const Range& y, const Range& z, const Range& w);
+
+    // Asynchronous generation, dispatches on the Executor of generator if first
+    std::shared_future<SharedBuffer> requestNoise(Noise& noise, const Range& x);
+    std::shared_future<SharedBuffer> requestNoise(Noise& noise, const Range& x, const Range& y);
+    std::shared_future<SharedBuffer> requestNoise(Noise& noise, const Range& x, const Range& y, const Range& z);
+    std::shared_future<SharedBuffer> requestNoise(Noise& noise, const Range& x, const Range& y, const Range& z, const Range& w);
+
+    // Getters/Setters
+    //! \brief Requests that started a dispatch
+    size_t getDispatched() const;
+    //! \brief Requests that attached to a dispatch in flight
+    size_t getMerged() const;
+    //! \brief Dispatches in flight
+    size_t getPending() const;
+
+protected:
+    typedef std::vector<unsigned long long> Key;
+
+    //! \brief dispatch in flight, run by whoever claims it first
+    struct Pending {
+        std::shared_future<SharedBuffer> future;
+        std::shared_ptr<std::atomic<bool>> claimed;
+        Executor::Task dispatch;
+    };
+
+    Generator& m_generator;
+    mutable std::mutex m_lock;
+    std::mutex m_generatorLock;
+    std::map<Key, Pending> m_pending;
+
+    size_t m_dispatched;
+    size_t m_merged;
+
+private:
+    Key makeKey(const Noise& noise, const Range* ranges, int dimensions) const;
+    std::shared_future<SharedBuffer> attach(Noise& noise, const Range* ranges, int dimensions, bool async);
+};
+
+#endif
@@ -0,0 +1,156 @@
+// SlicedRequest.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#include "SlicedRequest.h"
+
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+#define SLICE_FIRST 65536
+
+// initialization
+SlicedRequest::SlicedRequest(Generator& generator, const Range& x) : m_generator(generator) {
+    m_ranges.push_back(x);
+    init();
+}
+SlicedRequest::SlicedRequest(Generator& generator, const Range& x, const Range& y) : m_generator(generator) {
+    m_ranges.push_back(x);
+    m_ranges.push_back(y);
+    init();
+}
+SlicedRequest::SlicedRequest(Generator& generator, const Range& x, const Range& y, const Range& z) : m_generator(generator) {
+    m_ranges.push_back(x);
+    m_ranges.push_back(y);
+    m_ranges.push_back(z);
+    init();
+}
+SlicedRequest::SlicedRequest(Generator& generator, const Range& x, const Range& y, const Range& z, const Range& w) : m_generator(generator) {
+    m_ranges.push_back(x);
+    m_ranges.push_back(y);
+    m_ranges.push_back(z);
+    m_ranges.push_back(w);
+    init();
+}
+SlicedRequest::~SlicedRequest() {
+    if (m_result) delete[] m_result;
+}
+void SlicedRequest::init() {
+    m_size = 1;
+    for (const Range& r : m_ranges) m_size *= r.size;
+
+    m_done = 0;
+    m_failed = m_size == 0;
+    m_result = m_failed ? nullptr : new float[m_size];
+
+    m_minSlice = 4096;
+    m_maxSlice = 1 << 22;
+    m_sampleTime = 0;
+}
+
+// Generation
+bool SlicedRequest::generate(size_t count) {
+    m_generator.setSlice(m_done, count);
+
+    NoiseBuffer b(0, nullptr);
+    switch (m_ranges.size()) {
+    case 1:
+        b = m_generator.getNoise(m_ranges[0]);
+        break;
+    case 2:
+        b = m_generator.getNoise(m_ranges[0], m_ranges[1]);
+        break;
+    case 3:
+        b = m_generator.getNoise(m_ranges[0], m_ranges[1], m_ranges[2]);
+        break;
+    default:
+        b = m_generator.getNoise(m_ranges[0], m_ranges[1], m_ranges[2], m_ranges[3]);
+        break;
+    }
+
+    m_generator.setSlice(0, 0);
+    if (b.size != count) return false;
+
+    std::memcpy(m_result + m_done, b.data, sizeof(float) * count);
+    m_done += count;
+    return true;
+}
+bool SlicedRequest::step(double budgetMs) {
+    auto start = std::chrono::steady_clock::now();
+    bool first = true;
+
+    while (!isComplete()) {
+        double spent = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        // Slice size from time per sample measured so far
+        size_t count;
+        if (m_sampleTime > 0) count = (size_t)std::max(0.0, (budgetMs - spent) / m_sampleTime);
+        else count = std::min<size_t>(SLICE_FIRST, m_maxSlice);
+
+        if (count < m_minSlice) {
+            if (!first) break;
+            count = m_minSlice;
+        }
+        count = std::min(std::min(count, m_maxSlice), m_size - m_done);
+
+        auto sliceStart = std::chrono::steady_clock::now();
+        if (!generate(count)) {
+            m_failed = true;
+            break;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sliceStart).count();
+
+        // Smooth measurements, dispatch overhead is folded into time per sample
+        double sampleTime = ms / count;
+        m_sampleTime = m_sampleTime > 0 ? (m_sampleTime + sampleTime) * 0.5 : sampleTime;
+        first = false;
+    }
+
+    return isComplete();
+}
+bool SlicedRequest::isComplete() const {
+    return m_failed || m_done == m_size;
+}
+float SlicedRequest::getProgress() const {
+    return m_size ? (float)m_done / m_size : 1.0f;
+}
+NoiseBuffer SlicedRequest::getResult() {
+    if (m_failed || m_done != m_size || !m_result) return NoiseBuffer(0, nullptr);
+
+    NoiseBuffer b(m_size, m_result);
+    m_result = nullptr;
+    return b;
+}
+
+// Getters/Setters
+void SlicedRequest::setSliceLimits(size_t minSlice, size_t maxSlice) {
+    m_minSlice = minSlice ? minSlice : 1;
+    m_maxSlice = std::max(maxSlice, m_minSlice);
+}
+double SlicedRequest::getSampleTime() const {
+    return m_sampleTime;
+}
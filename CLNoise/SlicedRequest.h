@@ -0,0 +1,86 @@
+// SlicedRequest.h
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+#ifndef SlicedRequest_H
+#define SlicedRequest_H
+
+#include <cstdlib>
+#include <vector>
+#include "Generator.h"
+
+/*! \brief getNoise request split into slices, generated over several step() calls
+ * Keeps single dispatches short, so rendering is not starved and driver watchdog is not hit.
+ * Slice size adapts to measured time per sample. Noise set on generator must not change until complete
+ */
+class SlicedRequest {
+public:
+    //! \brief Create request, arguments are the same as of Generator::getNoise
+    SlicedRequest(Generator& generator, const Range& x);
+    SlicedRequest(Generator& generator, const Range& x, const Range& y);
+    SlicedRequest(Generator& generator, const Range& x, const Range& y, const Range& z);
+    SlicedRequest(Generator& generator, const Range& x, const Range& y, const Range& z, const Range& w);
+    ~SlicedRequest();
+
+    /*! \brief Generates slices until budgetMs milliseconds are spent
+     * At least one slice is generated per call
+     * \return true when request is complete or generation failed
+     */
+    bool step(double budgetMs);
+    bool isComplete() const;
+    //! \brief Returns part of samples generated so far, 0 to 1
+    float getProgress() const;
+
+    //! \brief Returns result once complete, empty buffer before or if generation failed
+    NoiseBuffer getResult();
+
+    // Getters/Setters
+    /*! \brief Sets bounds of slice size in samples
+     * Default: 4096 and 4M, maxSlice also bounds the first slice when nothing is measured yet
+     */
+    void setSliceLimits(size_t minSlice, size_t maxSlice);
+    //! \brief Returns measured time per sample in milliseconds, 0 before first slice
+    double getSampleTime() const;
+
+protected:
+    Generator& m_generator;
+    std::vector<Range> m_ranges;
+    size_t m_size;
+    size_t m_done;
+    bool m_failed;
+
+    float* m_result;
+
+    size_t m_minSlice;
+    size_t m_maxSlice;
+    double m_sampleTime;
+
+private:
+    void init();
+    bool generate(size_t count);
+};
+
+#endif
@@ -0,0 +1,140 @@
+// AsyncLaunch.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+// Checks that getNoiseAsync only queues work: a second request with other noise settings is
+// submitted while the first one is still running, and both results have to match getNoise.
+// Waiting is only reported when the first request is long enough to tell it from machine load.
+// Exits with 77 when there are no OpenCL devices, so CTest reports the test as skipped.
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <cmath>
+
+#include "CLNoise/CLNoise.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+//! \brief one async request, filled from the callback
+struct Pending {
+    mutex* guard;
+    condition_variable* signal;
+    bool done;
+    Clock::time_point finished;
+    NoiseBuffer result;
+};
+
+void on_done(void* data, NoiseBuffer&& result) {
+    Pending* p = (Pending*)data;
+    lock_guard<mutex> lock(*p->guard);
+    p->result = std::move(result);
+    p->finished = Clock::now();
+    p->done = true;
+    p->signal->notify_all();
+}
+
+bool same(const NoiseBuffer& a, const NoiseBuffer& b) {
+    if (!a.data || !b.data || a.size != b.size) return false;
+    for (size_t i = 0; i < a.size; i++)
+        if (fabs(a.data[i] - b.data[i]) > 1e-5f) return false;
+    return true;
+}
+
+bool test_device(const Device& device) {
+    cout << device.getInfo().name << ": ";
+
+    // Heavy request first, then a cheap one with different settings
+    Fractal fractal(6, 2.0f, 0.5f);
+    Noise heavy, light;
+    heavy.setNoiseType(NoiseType::SimplexFractal);
+    heavy.setFractal(&fractal);
+    light.setNoiseType(NoiseType::Value);
+    light.setSeed(7);
+    light.setFrequency(0.05f);
+
+    Range big(192, 0.0f, 1.0f), small(32, 0.0f, 1.0f);
+
+    // Build kernels and get reference results
+    Generator generator(device);
+    generator.setNoise(&heavy);
+    NoiseBuffer heavyRef = generator.getNoise(big, big, big);
+    generator.setNoise(&light);
+    NoiseBuffer lightRef = generator.getNoise(small, small, small);
+
+    mutex guard;
+    condition_variable signal;
+    Pending first = { &guard, &signal, false, Clock::time_point(), NoiseBuffer(0, nullptr) };
+    Pending second = { &guard, &signal, false, Clock::time_point(), NoiseBuffer(0, nullptr) };
+
+    Clock::time_point start = Clock::now();
+    generator.setNoise(&heavy);
+    if (!generator.getNoiseAsync(big, big, big, on_done, &first)) {
+        cout << "first submit failed\n";
+        return false;
+    }
+    Clock::time_point submitted = Clock::now();
+    generator.setNoise(&light);
+    if (!generator.getNoiseAsync(small, small, small, on_done, &second)) {
+        cout << "second submit failed\n";
+        return false;
+    }
+    Clock::time_point returned = Clock::now();
+
+    unique_lock<mutex> lock(guard);
+    signal.wait(lock, [&]() { return first.done && second.done; });
+
+    /* A blocking submit would wait for the whole first request. Only requests long enough that
+     * scheduling noise cannot explain the wait are judged, with a wide margin
+     */
+    chrono::duration<double, milli> submit = returned - submitted, latency = first.finished - start;
+    cout << "second submit " << submit.count() << " ms, first request " << latency.count() << " ms\n";
+    if (latency.count() >= 250 && submit.count() >= latency.count() * 0.9) {
+        cout << "  second submit waited for the first request\n";
+        return false;
+    }
+    if (!same(first.result, heavyRef) || !same(second.result, lightRef)) {
+        cout << "  async result differs from getNoise\n";
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    const vector<Device>& devices = Device::getDevices();
+    if (devices.empty()) {
+        cout << "No OpenCL devices found\n";
+        return 77;
+    }
+
+    bool ok = true;
+    for (const Device& device : devices)
+        ok = test_device(device) && ok;
+    return ok ? 0 : 1;
+}
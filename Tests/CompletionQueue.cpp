@@ -0,0 +1,153 @@
+// CompletionQueue.cpp
+//
+// MIT License
+//
+// Copyright(c) 2017 Oiltanker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is mentioned on GitHub profile
+//
+
+// Submits requests with different settings through a CompletionQueue, polls its descriptor until
+// every request is drained and checks ids and results against getNoise. The descriptor has to be
+// quiet once everything is drained. Built twice, with eventfd and with the pipe fallback.
+// Exits with 77 when there are no OpenCL devices, so CTest reports the test as skipped.
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <poll.h>
+
+#include "CLNoise/CLNoise.h"
+
+using namespace std;
+
+bool same(const NoiseBuffer& a, const NoiseBuffer& b) {
+    if (!a.data || !b.data || a.size != b.size) return false;
+    for (size_t i = 0; i < a.size; i++)
+        if (fabs(a.data[i] - b.data[i]) > 1e-5f) return false;
+    return true;
+}
+
+bool readable(int fd, int timeout) {
+    pollfd p = { fd, POLLIN, 0 };
+    return poll(&p, 1, timeout) == 1 && (p.revents & POLLIN);
+}
+
+bool test_device(const Device& device) {
+    cout << device.getInfo().name << ": ";
+
+    Fractal fractal(4, 2.0f, 0.5f);
+    Noise simplex, value, cellular;
+    simplex.setNoiseType(NoiseType::SimplexFractal);
+    simplex.setFractal(&fractal);
+    value.setNoiseType(NoiseType::Value);
+    value.setSeed(42);
+    value.setFrequency(0.05f);
+    cellular.setNoiseType(NoiseType::Cellular);
+    cellular.setCellularReturnType(CellularReturnType::Distance);
+
+    Range line(4096, -10.0f, 0.5f), plane(96, 3.0f, 1.0f), cube(24, 0.0f, 2.0f);
+
+    // References first, queued requests then run without other work in between
+    Generator generator(device);
+    map<unsigned long long, NoiseBuffer> expected;
+    vector<NoiseBuffer> refs;
+    generator.setNoise(&value);
+    refs.push_back(generator.getNoise(line));
+    generator.setNoise(&simplex);
+    refs.push_back(generator.getNoise(plane, plane));
+    generator.setNoise(&cellular);
+    refs.push_back(generator.getNoise(cube, cube, cube));
+
+    CompletionQueue queue(generator);
+    int fd = queue.getFd();
+    if (fd < 0) {
+        cout << "no descriptor\n";
+        return false;
+    }
+
+    vector<Completion> completions;
+    if (queue.drain(completions) != 0 || readable(fd, 0)) {
+        cout << "descriptor readable before any request\n";
+        return false;
+    }
+
+    unsigned long long ids[3];
+    generator.setNoise(&value);
+    ids[0] = queue.submit(line);
+    generator.setNoise(&simplex);
+    ids[1] = queue.submit(plane, plane);
+    generator.setNoise(&cellular);
+    ids[2] = queue.submit(cube, cube, cube);
+    for (int i = 0; i < 3; i++) {
+        if (!ids[i] || (i && ids[i] == ids[i - 1])) {
+            cout << "submit failed\n";
+            return false;
+        }
+        expected.emplace(ids[i], std::move(refs[i]));
+    }
+
+    // Event loop, descriptor wakes up once per batch of finished requests
+    while (completions.size() < 3) {
+        if (!readable(fd, 10000)) {
+            cout << "descriptor did not become readable, " << queue.getPending() << " pending\n";
+            return false;
+        }
+        if (queue.drain(completions) == 0) {
+            cout << "readable descriptor without finished requests\n";
+            return false;
+        }
+    }
+
+    if (queue.getPending() != 0 || readable(fd, 0)) {
+        cout << "descriptor still readable after drain\n";
+        return false;
+    }
+    for (const Completion& c : completions) {
+        auto e = expected.find(c.id);
+        if (e == expected.end()) {
+            cout << "unknown id " << c.id << "\n";
+            return false;
+        }
+        if (!same(c.result, e->second)) {
+            cout << "result of id " << c.id << " differs from getNoise\n";
+            return false;
+        }
+        expected.erase(e);
+    }
+
+    cout << "ok\n";
+    return true;
+}
+
+int main() {
+    const vector<Device>& devices = Device::getDevices();
+    if (devices.empty()) {
+        cout << "No OpenCL devices found\n";
+        return 77;
+    }
+
+    bool ok = true;
+    for (const Device& device : devices)
+        ok = test_device(device) && ok;
+    return ok ? 0 : 1;
+}